@@ -0,0 +1,441 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "skBench.h"
+#include "skColor.h"
+#include "skFastMath.h"
+#include "skMath.h"
+#include "skQuaternion.h"
+
+// Accuracy gate for the approximate math paths. Each function is swept
+// over its documented domain and compared with a double precision libm
+// reference rounded to float. The maximum and mean error in ulp are
+// printed next to the throughput of the function and of libm, and the
+// program exits with 1 when any error bound is exceeded, or when the
+// four lane form of a skFastMath function differs from the scalar form.
+//
+// By default every 61st float bit pattern is tested. --exhaustive tests
+// them all, which takes a while for the functions defined on all
+// positive floats. The --json, --filter and --counters options of
+// skBench apply to the throughput half.
+
+namespace
+{
+    const int Block = 4096;
+
+    SKuint32 Stride = 61;
+
+    // Maps floats onto integers in the same order, so that the
+    // difference of two mapped values is their distance in ulp.
+    int64_t order(float f)
+    {
+        int32_t i;
+        memcpy(&i, &f, sizeof i);
+        return i < 0 ? -(int64_t)(i & 0x7FFFFFFF) : (int64_t)i;
+    }
+
+    float unorder(int64_t o)
+    {
+        const uint32_t u = o < 0 ? 0x80000000u | (uint32_t)-o : (uint32_t)o;
+
+        float f;
+        memcpy(&f, &u, sizeof f);
+        return f;
+    }
+
+    double ulps(float a, float b)
+    {
+        if (std::isnan(a) || std::isnan(b))
+            return std::isnan(a) && std::isnan(b) ? 0 : INFINITY;
+        if (std::isinf(a) || std::isinf(b))
+            return a == b ? 0 : INFINITY;
+        return (double)std::llabs(order(a) - order(b));
+    }
+
+    struct Error
+    {
+        double   max    = 0;
+        double   sum    = 0;
+        SKuint64 count  = 0;
+        SKuint64 lanes  = 0;  // SIMD results that differ from the scalar ones
+        float    worst  = 0;  // input with the largest error
+        float    worstY = 0;
+
+        void add(double e, float x, float y = 0)
+        {
+            if (e > max)
+                max = e, worst = x, worstY = y;
+            sum += e;
+            ++count;
+        }
+    };
+
+    struct Row
+    {
+        std::string name;
+        std::string domain;
+        Error       error;
+        double      bound;
+    };
+
+    std::vector<Row> Rows;
+
+    typedef float (*Scalar)(float);
+    typedef skSimd4f (*Simd)(const skSimd4f&);
+    typedef double (*Reference)(double);
+
+    float  In[Block];
+    float  Out[Block];
+    float  Lanes[Block];
+    float  Y[Block];
+    double Ref[Block];
+
+    void check(Error& e, int n, Scalar scalar, Simd simd, Reference ref)
+    {
+        for (int i = 0; i < n; ++i)
+            Out[i] = scalar(In[i]);
+
+        if (simd)
+        {
+            for (int i = n; i < (n + 3) / 4 * 4; ++i)
+                In[i] = In[0];
+            for (int i = 0; i < n; i += 4)
+                simd(skSimd4f::load(In + i)).store(Lanes + i);
+        }
+
+        for (int i = 0; i < n; ++i)
+        {
+            Ref[i] = ref((double)In[i]);
+            e.add(ulps(Out[i], (float)Ref[i]), In[i]);
+
+            if (simd && memcmp(Out + i, Lanes + i, sizeof(float)) != 0)
+                ++e.lanes;
+        }
+    }
+
+    void unary(const char* name, float lo, float hi, double bound, Scalar scalar, Simd simd, Reference ref)
+    {
+        Row row;
+        row.name  = name;
+        row.bound = bound;
+
+        char domain[64];
+        snprintf(domain, sizeof domain, "[%g, %g]", (double)lo, (double)hi);
+        row.domain = domain;
+
+        const int64_t first = order(lo), last = order(hi);
+
+        int n = 0;
+        for (int64_t o = first; o <= last; o += Stride)
+        {
+            In[n++] = unorder(o);
+            if (n == Block)
+            {
+                check(row.error, n, scalar, simd, ref);
+                n = 0;
+            }
+        }
+        if (n > 0)
+            check(row.error, n, scalar, simd, ref);
+
+        Rows.push_back(row);
+    }
+
+    // xorshift, so that the sweeps repeat from run to run.
+    SKuint32 Seed = 2463534242u;
+
+    SKuint32 next()
+    {
+        Seed ^= Seed << 13;
+        Seed ^= Seed >> 17;
+        Seed ^= Seed << 5;
+        return Seed;
+    }
+
+    // Finite floats with uniformly distributed exponents and signs.
+    float randomFloat()
+    {
+        for (;;)
+        {
+            const SKuint32 u = next();
+
+            float f;
+            memcpy(&f, &u, sizeof f);
+            if (std::isfinite(f))
+                return f;
+        }
+    }
+
+    void atan2Sweep()
+    {
+        Row row;
+        row.name   = "skFastMath::atan2";
+        row.domain = "finite x, y";
+        row.bound  = 3;
+
+        const SKuint64 count = (SKuint64(1) << 32) / Stride / 16;
+        for (SKuint64 k = 0; k < count; k += Block)
+        {
+            for (int i = 0; i < Block; ++i)
+                Y[i] = randomFloat(), In[i] = randomFloat();
+
+            for (int i = 0; i < Block; i += 4)
+                skFastMath::atan2(skSimd4f::load(Y + i), skSimd4f::load(In + i)).store(Lanes + i);
+
+            for (int i = 0; i < Block; ++i)
+            {
+                Out[i] = skFastMath::atan2(Y[i], In[i]);
+                row.error.add(ulps(Out[i], (float)atan2((double)Y[i], (double)In[i])), In[i], Y[i]);
+
+                if (memcmp(Out + i, Lanes + i, sizeof(float)) != 0)
+                    ++row.error.lanes;
+            }
+        }
+        Rows.push_back(row);
+    }
+
+    // Error of the normalized length, in units of SK_EPSILON.
+    void quaternionSweep()
+    {
+        Row row;
+        row.name   = "skQuaternion::normalize";
+        row.domain = "|q| in [1e-3, 1e3]";
+        row.bound  = 4;
+
+        const SKuint64 count = (SKuint64(1) << 30) / Stride;
+        for (SKuint64 k = 0; k < count; ++k)
+        {
+            const double scale = pow(10.0, -3.0 + 6.0 * (double)(next() >> 8) / 16777216.0);
+
+            double c[4];
+            for (double& v : c)
+                v = ((double)(next() >> 8) / 8388608.0 - 1.0) * scale;
+
+            skQuaternion q((skScalar)c[0], (skScalar)c[1], (skScalar)c[2], (skScalar)c[3]);
+            if (q.length2() <= SK_EPSILON)
+                continue;
+
+            q.normalize();
+
+            const double len = sqrt((double)q.w * q.w + (double)q.x * q.x + (double)q.y * q.y + (double)q.z * q.z);
+            row.error.add(fabs(len - 1.0) / SK_EPSILON, (float)scale);
+        }
+        Rows.push_back(row);
+    }
+
+    // Absolute round trip error through HSV. The hue is kept in whole
+    // degrees, which moves a channel by up to 1/60 of the chroma.
+    void colorSweep()
+    {
+        Row row;
+        row.name   = "skColorUtils::convert(HSV)";
+        row.domain = "rgb in [0, 1]";
+        row.bound  = 1.0 / 60.0 + 1e-5;
+
+        const int steps = Stride == 1 ? 256 : 64;
+        for (int r = 0; r <= steps; ++r)
+        {
+            for (int g = 0; g <= steps; ++g)
+            {
+                for (int b = 0; b <= steps; ++b)
+                {
+                    const skColor src(skScalar(r) / steps, skScalar(g) / steps, skScalar(b) / steps, 1);
+
+                    skColorHSV hsv;
+                    skColor    dst;
+                    skColorUtils::convert(hsv, src);
+                    skColorUtils::convert(dst, hsv);
+
+                    const double e = skMax3(fabs((double)dst.r - src.r),
+                                            fabs((double)dst.g - src.g),
+                                            fabs((double)dst.b - src.b));
+                    row.error.add(e, (float)src.r, (float)src.g);
+                }
+            }
+        }
+        Rows.push_back(row);
+    }
+
+    void fill(float lo, float hi)
+    {
+        for (int i = 0; i < Block; ++i)
+            In[i] = lo + (hi - lo) * float(i) / float(Block);
+    }
+
+    template <typename Fn>
+    void time(skBench& bench, const std::string& name, Fn fn)
+    {
+        bench.run(name.c_str(), Block, [&] {
+            for (int i = 0; i < Block; ++i)
+                Out[i] = fn(In[i]);
+        });
+    }
+
+    void throughput(skBench& bench)
+    {
+        fill(-100.f, 100.f);
+        time(bench, "sinf", [](float x) { return sinf(x); });
+        time(bench, "skFastMath::sin", [](float x) { return skFastMath::sin(x); });
+        time(bench, "cosf", [](float x) { return cosf(x); });
+        time(bench, "skFastMath::cos", [](float x) { return skFastMath::cos(x); });
+        time(bench, "expf", [](float x) { return expf(x * 0.5f); });
+        time(bench, "skFastMath::exp", [](float x) { return skFastMath::exp(x * 0.5f); });
+        time(bench, "atan2f", [](float x) { return atan2f(x, 1.5f); });
+        time(bench, "skFastMath::atan2", [](float x) { return skFastMath::atan2(x, 1.5f); });
+
+        fill(0.001f, 1000.f);
+        time(bench, "logf", [](float x) { return logf(x); });
+        time(bench, "skFastMath::log", [](float x) { return skFastMath::log(x); });
+        time(bench, "1 / sqrtf", [](float x) { return 1.f / sqrtf(x); });
+        time(bench, "skFastMath::rsqrt", [](float x) { return skFastMath::rsqrt(x); });
+    }
+
+    std::string config()
+    {
+#ifdef SK_DOUBLE
+        std::string r = "double";
+#else
+        std::string r = "float";
+#endif
+#ifdef SK_MATH_HEADER_ONLY
+        r += ", header only";
+#endif
+#ifdef SK_FAST_MATH
+        r += ", fast math";
+#endif
+        if (Stride == 1)
+            r += ", exhaustive";
+        return r;
+    }
+
+    double nsPerOp(const skBench& bench, const std::string& name)
+    {
+        for (const skBench::Result& r : bench.results())
+        {
+            if (r.name == name)
+                return r.nsPerElement;
+        }
+        return -1;
+    }
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--exhaustive") == 0)
+            Stride = 1;
+    }
+
+    skBench bench(argc, argv);
+    throughput(bench);
+
+    // clang-format off
+    unary("skFastMath::sin", -8192.f, 8192.f, 2, [](float x) { return skFastMath::sin(x); }, [](const skSimd4f& x) { return skFastMath::sin(x); }, sin);
+    unary("skFastMath::cos", -8192.f, 8192.f, 2, [](float x) { return skFastMath::cos(x); }, [](const skSimd4f& x) { return skFastMath::cos(x); }, cos);
+    unary("skFastMath::exp", -87.3f, 88.7f, 1, [](float x) { return skFastMath::exp(x); }, [](const skSimd4f& x) { return skFastMath::exp(x); }, exp);
+    unary("skFastMath::log", FLT_TRUE_MIN, FLT_MAX, 1, [](float x) { return skFastMath::log(x); }, [](const skSimd4f& x) { return skFastMath::log(x); }, log);
+    unary("skFastMath::rsqrt", FLT_MIN, FLT_MAX, 4, [](float x) { return skFastMath::rsqrt(x); }, [](const skSimd4f& x) { return skFastMath::rsqrt(x); }, [](double x) { return 1 / sqrt(x); });
+    atan2Sweep();
+
+#ifndef SK_DOUBLE
+    // The skMath.h entry points, in whichever mode they were built.
+#ifdef SK_FAST_MATH
+    const double trig = 2, rsqrt = 4;
+#else
+    const double trig = 1, rsqrt = 1;
+#endif
+    unary("skSin", -8192.f, 8192.f, trig, [](float x) { return skSin(x); }, nullptr, sin);
+    unary("skCos", -8192.f, 8192.f, trig, [](float x) { return skCos(x); }, nullptr, cos);
+    unary("skExp", -87.3f, 88.7f, 1, [](float x) { return skExp(x); }, nullptr, exp);
+    unary("skLog", FLT_TRUE_MIN, FLT_MAX, 1, [](float x) { return skLog(x); }, nullptr, log);
+    unary("skRSqrt", FLT_MIN, FLT_MAX, rsqrt, [](float x) { return skRSqrt(x); }, nullptr, [](double x) { return 1 / sqrt(x); });
+    unary("skSqrt", 0.f, FLT_MAX, 0, [](float x) { return skSqrt(x); }, nullptr, sqrt);
+#endif
+    // clang-format on
+
+    quaternionSweep();
+    colorSweep();
+
+    // The libm function each skFastMath function is timed against.
+    static const struct
+    {
+        const char* name;
+        const char* libm;
+    } Timed[] = {
+        {"skFastMath::sin", "sinf"},
+        {"skFastMath::cos", "cosf"},
+        {"skFastMath::exp", "expf"},
+        {"skFastMath::log", "logf"},
+        {"skFastMath::rsqrt", "1 / sqrtf"},
+        {"skFastMath::atan2", "atan2f"},
+    };
+
+    FILE* fp     = bench.log();
+    int   failed = 0;
+
+    fprintf(fp,
+            "\n%-28s %-28s %12s %10s %10s %7s %10s %10s  result\n",
+            "function", "domain", "inputs", "max", "mean", "bound", "ns/op", "libm ns");
+
+    for (const Row& row : Rows)
+    {
+        double fast = -1, libm = -1;
+        for (const auto& t : Timed)
+        {
+            if (row.name == t.name)
+                fast = nsPerOp(bench, t.name), libm = nsPerOp(bench, t.libm);
+        }
+
+        const bool pass = row.error.max <= row.bound && row.error.lanes == 0;
+        failed += pass ? 0 : 1;
+
+        fprintf(fp,
+                "%-28s %-28s %12llu %10.3g %10.3g %7.3g ",
+                row.name.c_str(),
+                row.domain.c_str(),
+                (unsigned long long)row.error.count,
+                row.error.max,
+                row.error.count ? row.error.sum / (double)row.error.count : 0.0,
+                row.bound);
+
+        if (fast >= 0)
+            fprintf(fp, "%10.3f %10.3f  ", fast, libm);
+        else
+            fprintf(fp, "%10s %10s  ", "-", "-");
+
+        if (pass)
+            fprintf(fp, "ok\n");
+        else if (row.error.lanes)
+            fprintf(fp, "FAILED, %llu lanes differ from the scalar form\n", (unsigned long long)row.error.lanes);
+        else
+            fprintf(fp, "FAILED at %.9g %.9g\n", (double)row.error.worst, (double)row.error.worstY);
+    }
+
+    const int json = bench.finish("skAccuracy", config().c_str());
+    return failed ? 1 : json;
+}
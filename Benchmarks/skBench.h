@@ -0,0 +1,302 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skBench_h_
+#define _skBench_h_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "skBenchCounters.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+// Keeps results from being computed once and hoisted out of the repeat loop.
+#define SK_BENCH_CLOBBER() __asm__ __volatile__("" ::: "memory")
+#else
+#include <intrin.h>
+#define SK_BENCH_CLOBBER() _ReadWriteBarrier()
+#endif
+
+/// <summary>
+/// Timing harness for the benchmark programs.
+///
+/// Each case is a function that processes a fixed number of elements.
+/// The harness repeats it until a sample lasts at least MinSampleNs,
+/// takes Samples samples and reports the median as ns per element and
+/// elements per second. Results are printed as they complete, and are
+/// written as JSON when the program is started with --json [file], to
+/// stdout when no file is given, so two runs can be compared.
+///
+/// --filter text only runs the cases whose name contains text.
+///
+/// --counters runs one more sample under skBenchCounters and adds the
+/// instructions per cycle, the cache and branch misses per element and,
+/// for cases that give the bytes they touch per element, the bytes per
+/// cycle. Low IPC with high bytes per cycle or many LLC misses points to
+/// a memory bound kernel.
+/// </summary>
+class skBench
+{
+public:
+    struct Result
+    {
+        std::string name;
+        double      nsPerElement;
+        double      elementsPerSecond;
+        double      repeats;
+        double      bytesPerElement;
+
+        // Event counts per element, -1 when not measured.
+        skBenchCounters::Values counters;
+    };
+
+    static constexpr int    Samples     = 5;
+    static constexpr double MinSampleNs = 2e6;
+
+private:
+    std::vector<Result> m_results;
+    const char*         m_filter;
+    const char*         m_json;
+    bool                m_jsonRequested;
+    FILE*               m_log;
+    skBenchCounters*    m_counters;
+
+public:
+    skBench(int argc, char** argv) :
+        m_filter(nullptr),
+        m_json(nullptr),
+        m_jsonRequested(false),
+        m_log(stdout),
+        m_counters(nullptr)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            if (strcmp(argv[i], "--json") == 0)
+            {
+                m_jsonRequested = true;
+                if (i + 1 < argc && argv[i + 1][0] != '-')
+                    m_json = argv[++i];
+            }
+            else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+                m_filter = argv[++i];
+            else if (strcmp(argv[i], "--counters") == 0 && !m_counters)
+                m_counters = new skBenchCounters();
+        }
+
+        // Keeps stdout clean when the report goes there.
+        if (m_jsonRequested && !m_json)
+            m_log = stderr;
+
+        if (m_counters && !m_counters->available())
+        {
+            fprintf(stderr, "performance counters are not available, see perf_event_paranoid\n");
+            delete m_counters;
+            m_counters = nullptr;
+        }
+    }
+
+    ~skBench()
+    {
+        delete m_counters;
+    }
+
+    skBench(const skBench&)            = delete;
+    skBench& operator=(const skBench&) = delete;
+
+    /// <summary>
+    /// Times fn, which processes elements elements per call and touches
+    /// bytes bytes of memory for each of them, when known.
+    /// </summary>
+    template <typename Fn>
+    void run(const char* name, size_t elements, Fn fn, size_t bytes = 0)
+    {
+        if (m_filter && !strstr(name, m_filter))
+            return;
+
+        fn();
+        SK_BENCH_CLOBBER();
+
+        // Grows the repeat count until one sample is long enough to time.
+        size_t repeats = 1;
+        while (time(fn, repeats) < MinSampleNs && repeats < (size_t(1) << 30))
+            repeats *= 2;
+
+        double samples[Samples];
+        for (double& sample : samples)
+            sample = time(fn, repeats);
+
+        std::sort(samples, samples + Samples);
+
+        Result r;
+        r.name              = name;
+        r.repeats           = (double)repeats;
+        r.nsPerElement      = samples[Samples / 2] / ((double)repeats * (double)elements);
+        r.elementsPerSecond = r.nsPerElement > 0 ? 1e9 / r.nsPerElement : 0;
+        r.bytesPerElement   = (double)bytes;
+
+        fprintf(m_log, "%-36s %10.3f ns/op %12.4g elements/s\n", name, r.nsPerElement, r.elementsPerSecond);
+
+        for (double& c : r.counters)
+            c = -1;
+
+        if (m_counters)
+        {
+            m_counters->start();
+            time(fn, repeats);
+            m_counters->stop(r.counters);
+
+            const double n = (double)repeats * (double)elements;
+            for (double& c : r.counters)
+            {
+                if (c >= 0)
+                    c /= n;
+            }
+            printCounters(r);
+        }
+        m_results.push_back(r);
+    }
+
+    const std::vector<Result>& results() const
+    {
+        return m_results;
+    }
+
+    /// <summary>
+    /// Returns the stream progress is printed to, stderr when the JSON
+    /// report goes to stdout.
+    /// </summary>
+    FILE* log() const
+    {
+        return m_log;
+    }
+
+    /// <summary>
+    /// Writes the JSON report if one was requested. Returns the exit code.
+    /// </summary>
+    int finish(const char* suite, const char* config) const
+    {
+        if (!m_jsonRequested)
+            return 0;
+
+        FILE* fp = m_json ? fopen(m_json, "w") : stdout;
+        if (!fp)
+        {
+            fprintf(stderr, "cannot open %s\n", m_json);
+            return 1;
+        }
+
+        fprintf(fp, "{\n  \"suite\": \"%s\",\n  \"config\": \"%s\",\n  \"benchmarks\": [\n", suite, config);
+        for (size_t i = 0; i < m_results.size(); ++i)
+        {
+            const Result& r = m_results[i];
+            fprintf(fp,
+                    "    {\"name\": \"%s\", \"ns_per_op\": %.6g, \"elements_per_second\": %.6g, \"repeats\": %.0f",
+                    r.name.c_str(),
+                    r.nsPerElement,
+                    r.elementsPerSecond,
+                    r.repeats);
+
+            if (m_counters)
+            {
+                fprintf(fp, ",\n     \"per_op\": {");
+                for (int e = 0; e < skBenchCounters::EventCount; ++e)
+                {
+                    fprintf(fp, "%s\"%s\": ", e ? ", " : "", skBenchCounters::name(e));
+                    number(fp, r.counters[e]);
+                }
+                fprintf(fp, "},\n     \"ipc\": ");
+                number(fp, ipc(r));
+                fprintf(fp, ", \"bytes_per_cycle\": ");
+                number(fp, bytesPerCycle(r));
+            }
+            fprintf(fp, "}%s\n", i + 1 < m_results.size() ? "," : "");
+        }
+        fprintf(fp, "  ]\n}\n");
+
+        if (fp != stdout)
+            fclose(fp);
+        return 0;
+    }
+
+private:
+    static double ipc(const Result& r)
+    {
+        const double cycles       = r.counters[skBenchCounters::Cycles];
+        const double instructions = r.counters[skBenchCounters::Instructions];
+        return cycles > 0 && instructions >= 0 ? instructions / cycles : -1;
+    }
+
+    static double bytesPerCycle(const Result& r)
+    {
+        const double cycles = r.counters[skBenchCounters::Cycles];
+        return cycles > 0 && r.bytesPerElement > 0 ? r.bytesPerElement / cycles : -1;
+    }
+
+    // Writes a measured value, or null for -1.
+    static void number(FILE* fp, double v)
+    {
+        if (v < 0)
+            fprintf(fp, "null");
+        else
+            fprintf(fp, "%.6g", v);
+    }
+
+    void printCounters(const Result& r) const
+    {
+        static const char* Labels[skBenchCounters::EventCount] = {
+            "cycles",
+            "instr",
+            "L1D miss",
+            "LLC miss",
+            "br miss",
+        };
+
+        fprintf(m_log, "   ");
+        if (ipc(r) >= 0)
+            fprintf(m_log, " IPC %.2f", ipc(r));
+        if (bytesPerCycle(r) >= 0)
+            fprintf(m_log, "  bytes/cycle %.2f", bytesPerCycle(r));
+        for (int e = 0; e < skBenchCounters::EventCount; ++e)
+        {
+            if (r.counters[e] >= 0)
+                fprintf(m_log, "  %s/op %.3g", Labels[e], r.counters[e]);
+        }
+        fprintf(m_log, "\n");
+    }
+
+    template <typename Fn>
+    static double time(Fn& fn, size_t repeats)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < repeats; ++r)
+        {
+            fn();
+            SK_BENCH_CLOBBER();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+};
+
+#endif  //_skBench_h_
@@ -0,0 +1,181 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skBenchCounters_h_
+#define _skBenchCounters_h_
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// <summary>
+/// Hardware performance counters for the calling thread, read through
+/// Linux perf_event. Each event is opened on its own so that one the
+/// machine lacks does not disable the others, and the counts are scaled
+/// by enabled / running time when the kernel multiplexes them. Counting
+/// is limited to user space, which perf_event_paranoid levels up to 2
+/// allow. On other systems, or when no event opens, available() is false.
+/// </summary>
+class skBenchCounters
+{
+public:
+    enum Event
+    {
+        Cycles,
+        Instructions,
+        L1DMisses,
+        LLCMisses,
+        BranchMisses,
+        EventCount
+    };
+
+    /// <summary>
+    /// Count of each event over the last start() stop() pair, or -1 when
+    /// the event is not available.
+    /// </summary>
+    typedef double Values[EventCount];
+
+private:
+    int m_fd[EventCount];
+
+public:
+    skBenchCounters()
+    {
+        for (int& fd : m_fd)
+            fd = -1;
+
+#ifdef __linux__
+        const uint64_t l1dReadMiss = PERF_COUNT_HW_CACHE_L1D |
+                                     (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+        m_fd[Cycles]       = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        m_fd[Instructions] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        m_fd[L1DMisses]    = open(PERF_TYPE_HW_CACHE, l1dReadMiss);
+        m_fd[LLCMisses]    = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        m_fd[BranchMisses] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    }
+
+    ~skBenchCounters()
+    {
+#ifdef __linux__
+        for (int fd : m_fd)
+        {
+            if (fd >= 0)
+                close(fd);
+        }
+#endif
+    }
+
+    skBenchCounters(const skBenchCounters&)            = delete;
+    skBenchCounters& operator=(const skBenchCounters&) = delete;
+
+    bool available() const
+    {
+        for (int fd : m_fd)
+        {
+            if (fd >= 0)
+                return true;
+        }
+        return false;
+    }
+
+    static const char* name(int event)
+    {
+        static const char* Names[EventCount] = {
+            "cycles",
+            "instructions",
+            "l1d_misses",
+            "llc_misses",
+            "branch_misses",
+        };
+        return Names[event];
+    }
+
+    void start()
+    {
+#ifdef __linux__
+        for (int fd : m_fd)
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    void stop(Values values)
+    {
+        for (int e = 0; e < EventCount; ++e)
+            values[e] = -1;
+
+#ifdef __linux__
+        for (int fd : m_fd)
+        {
+            if (fd >= 0)
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+
+        for (int e = 0; e < EventCount; ++e)
+        {
+            if (m_fd[e] < 0)
+                continue;
+
+            // value, time enabled, time running
+            uint64_t r[3];
+            if (read(m_fd[e], r, sizeof r) != (ssize_t)sizeof r || r[2] == 0)
+                continue;
+
+            values[e] = (double)r[0] * ((double)r[1] / (double)r[2]);
+        }
+#endif
+    }
+
+private:
+#ifdef __linux__
+    static int open(uint32_t type, uint64_t config)
+    {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof attr);
+
+        attr.size           = sizeof attr;
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+};
+
+#endif  //_skBenchCounters_h_
@@ -0,0 +1,246 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skBench.h"
+#include "skBigRational.h"
+#include "skBoundingBox3D.h"
+#include "skColor.h"
+#include "skMatrix3.h"
+#include "skMatrix4.h"
+#include "skQuaternion.h"
+#include "skRandom.h"
+#include "skRational.h"
+#include "skRectangle.h"
+#include "skSimdDispatch.h"
+#include "skVector2.h"
+#include "skVector3.h"
+
+// Per element cost of the core value types. Every case reads from the
+// input arrays and writes to an output array, and the checksums are
+// printed at the end so that no case can be optimized away.
+
+namespace
+{
+    const int Count = 1024;
+
+    skVector2    V2[Count], W2[Count], R2[Count];
+    skVector3    V3[Count], W3[Count], R3[Count];
+    skVector3A   V3A[Count], W3A[Count], R3A[Count];
+    skMatrix3    A3[Count], B3[Count], M3[Count];
+    skMatrix4    A4[Count], B4[Count], M4[Count];
+    skQuaternion QA[Count], QB[Count], QR[Count];
+    skColor      C[Count], CR[Count];
+    skColorHSV   HSV[Count];
+    skColori     CI[Count];
+    skRational   QA64[Count], QB64[Count], QR64[Count];
+    skRectangle  RA[Count], RB[Count];
+    skScalar     S[Count];
+    SKint32      I[Count];
+
+    skScalar        Angle[Count], SinR[Count], CosR[Count];
+    skBoundingBox3D Box[Count];
+#ifndef SK_DOUBLE
+    SKuint32 Hits[Count];
+#endif
+
+    const int      BigCount = 64;
+    skBigRational* BA;
+    skBigRational* BB;
+    skBigRational* BR;
+
+    skScalar frac(int i, int m)
+    {
+        return skScalar(i % m) / skScalar(m);
+    }
+
+    void fill()
+    {
+        for (int i = 0; i < Count; ++i)
+        {
+            const skScalar a = frac(i, 17), b = frac(i, 29), c = frac(i, 7);
+
+            V2[i] = skVector2(1 + a, b - c);
+            W2[i] = skVector2(c, 2 - a);
+            V3[i] = skVector3(1 + a, b, 2 - c);
+            W3[i] = skVector3(c, 1 - a, b + 1);
+
+            V3A[i] = V3[i];
+            W3A[i] = W3[i];
+
+            A3[i].fromAngles(a, b, c);
+            B3[i].fromAngles(c, a, b);
+            A4[i] = skMatrix4(1 + a, b, 0, c, 0, 2, a, 1, b, 0, 3, 2, 0, 0, 0, 1);
+            B4[i] = skMatrix4(2, 0, c, 3, a, 1 + b, 0, 1, 0, c, 1, 4, 0, 0, 0, 1);
+
+            QA[i] = skQuaternion(a, b, c);
+            QB[i] = skQuaternion(c, a, b);
+
+            C[i] = skColor(a, b, c, 1);
+            skColorUtils::convert(HSV[i], C[i]);
+            skColorUtils::convert(CI[i], C[i]);
+
+            QA64[i] = skRational(i % 97 + 1, i % 89 + 2);
+            QB64[i] = skRational(i % 83 + 3, i % 79 + 1);
+
+            RA[i] = skRectangle(a * 10, b * 10, 1 + c * 5, 1 + a * 5);
+            RB[i] = skRectangle(b * 10, c * 10, 1 + a * 5, 1 + b * 5);
+
+            Angle[i] = (a - skScalar(0.5)) * 20;
+            Box[i]   = skBoundingBox3D(a * 8 - 4, b * 8 - 4, c * 8, a * 8 - 3, b * 8 - 3, c * 8 + 1);
+        }
+
+        for (int i = 0; i < BigCount; ++i)
+        {
+            BA[i] = skBigRational(skRational(i * 7919 + 13, i * 104729 + 7));
+            BB[i] = skBigRational(skRational(i * 6007 + 5, i * 3001 + 11));
+        }
+    }
+
+    double checksum()
+    {
+        double r = 0;
+        for (int i = 0; i < Count; ++i)
+        {
+            r += R2[i].x + R3[i].y + R3A[i].z + M3[i].m[1][2] + M4[i].m[2][3] + QR[i].w;
+            r += CR[i].g + S[i] + (double)I[i] + (double)(skScalar)QR64[i];
+            r += SinR[i] + CosR[i];
+        }
+        for (int i = 0; i < BigCount; ++i)
+            r += BR[i].toDouble();
+        return r;
+    }
+
+    std::string config()
+    {
+#ifdef SK_DOUBLE
+        std::string r = "double";
+#else
+        std::string r = "float";
+#endif
+#ifdef SK_MATH_HEADER_ONLY
+        r += ", header only";
+#endif
+#ifdef SK_FAST_MATH
+        r += ", fast math";
+#endif
+        r += ", ";
+        r += skSimdDispatch::name(skSimdDispatch::level());
+        return r;
+    }
+
+    template <typename Op>
+    void each(Op op)
+    {
+        for (int i = 0; i < Count; ++i)
+            op(i);
+    }
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<skBigRational> big(3 * BigCount);
+    BA = big.data();
+    BB = BA + BigCount;
+    BR = BB + BigCount;
+
+    fill();
+    skRandInit();
+
+    skBench bench(argc, argv);
+
+    bench.run("skVector2::operator+", Count, [] { each([](int i) { R2[i] = V2[i] + W2[i]; }); }, 3 * sizeof(skVector2));
+    bench.run("skVector2::dot", Count, [] { each([](int i) { S[i] = V2[i].dot(W2[i]); }); }, 2 * sizeof(skVector2) + sizeof(skScalar));
+    bench.run("skVector2::normalized", Count, [] { each([](int i) { R2[i] = V2[i].normalized(); }); }, 2 * sizeof(skVector2));
+
+    bench.run("skVector3::operator+", Count, [] { each([](int i) { R3[i] = V3[i] + W3[i]; }); }, 3 * sizeof(skVector3));
+    bench.run("skVector3::dot", Count, [] { each([](int i) { S[i] = V3[i].dot(W3[i]); }); }, 2 * sizeof(skVector3) + sizeof(skScalar));
+    bench.run("skVector3::cross", Count, [] { each([](int i) { R3[i] = V3[i].cross(W3[i]); }); }, 3 * sizeof(skVector3));
+    bench.run("skVector3::length", Count, [] { each([](int i) { S[i] = V3[i].length(); }); }, sizeof(skVector3) + sizeof(skScalar));
+    bench.run("skVector3::normalized", Count, [] { each([](int i) { R3[i] = V3[i].normalized(); }); }, 2 * sizeof(skVector3));
+
+    bench.run("skMatrix3::operator*", Count, [] { each([](int i) { M3[i] = A3[i] * B3[i]; }); }, 3 * sizeof(skMatrix3));
+    bench.run("skMatrix3::operator*(skVector3)", Count, [] { each([](int i) { R3[i] = A3[i] * V3[i]; }); }, sizeof(skMatrix3) + 2 * sizeof(skVector3));
+    bench.run("skMatrix3::transposed", Count, [] { each([](int i) { M3[i] = A3[i].transposed(); }); }, 2 * sizeof(skMatrix3));
+
+    bench.run("skMatrix4::operator*", Count, [] { each([](int i) { M4[i] = A4[i] * B4[i]; }); }, 3 * sizeof(skMatrix4));
+    bench.run("skMatrix4::multAssign", Count, [] { each([](int i) { M4[i].multAssign(A4[i], B4[i]); }); }, 3 * sizeof(skMatrix4));
+    bench.run("skMatrix4::inverted", Count, [] { each([](int i) { M4[i] = A4[i].inverted(); }); }, 2 * sizeof(skMatrix4));
+    bench.run("skMatrix4::det", Count, [] { each([](int i) { S[i] = A4[i].det(); }); }, sizeof(skMatrix4) + sizeof(skScalar));
+
+    bench.run("skQuaternion::operator*", Count, [] { each([](int i) { QR[i] = QA[i] * QB[i]; }); }, 3 * sizeof(skQuaternion));
+    bench.run("skQuaternion::operator*(skVector3)", Count, [] { each([](int i) { R3[i] = QA[i] * V3[i]; }); }, sizeof(skQuaternion) + 2 * sizeof(skVector3));
+    bench.run("skQuaternion::normalized", Count, [] { each([](int i) { QR[i] = QB[i].normalized(); }); }, 2 * sizeof(skQuaternion));
+
+    bench.run("skColorUtils::convert(HSV)", Count, [] { each([](int i) { skColorUtils::convert(HSV[i], C[i]); }); }, sizeof(skColor) + sizeof(skColorHSV));
+    bench.run("skColorUtils::convert(RGB)", Count, [] { each([](int i) { skColorUtils::convert(CR[i], HSV[i]); }); }, sizeof(skColorHSV) + sizeof(skColor));
+    bench.run("skColorUtils::convert(skColori)", Count, [] { each([](int i) { skColorUtils::convert(CI[i], C[i]); }); }, sizeof(skColor) + sizeof(skColori));
+    bench.run("skColor(skColori)", Count, [] { each([](int i) { CR[i] = skColor(CI[i]); }); }, sizeof(skColori) + sizeof(skColor));
+
+    bench.run("skRational::operator+", Count, [] { each([](int i) { QR64[i] = QA64[i] + QB64[i]; }); }, 3 * sizeof(skRational));
+    bench.run("skRational::operator*", Count, [] { each([](int i) { QR64[i] = QA64[i] * QB64[i]; }); }, 3 * sizeof(skRational));
+    bench.run("skRational::operator/", Count, [] { each([](int i) { QR64[i] = QA64[i] / QB64[i]; }); }, 3 * sizeof(skRational));
+
+    bench.run("skBigRational::operator+", BigCount, [] {
+        for (int i = 0; i < BigCount; ++i)
+            BR[i] = BA[i] + BB[i];
+    });
+    bench.run("skBigRational::operator*", BigCount, [] {
+        for (int i = 0; i < BigCount; ++i)
+            BR[i] = BA[i] * BB[i];
+    });
+
+    bench.run("skUnitRand", Count, [] { each([](int i) { S[i] = skUnitRand(); }); }, sizeof(skScalar));
+    bench.run("skRandIntRange", Count, [] { each([](int i) { I[i] = skRandIntRange(-100, 100); }); }, sizeof(SKint32));
+
+    bench.run("skRectangle::contains", Count, [] { each([](int i) { I[i] = RA[i].contains(V2[i].x * 5, V2[i].y * 5); }); }, sizeof(skRectangle) + sizeof(skVector2) + sizeof(SKint32));
+    bench.run("skRectangle::clipped", Count, [] { each([](int i) { I[i] = RA[i].clipped(RB[i]); }); }, 2 * sizeof(skRectangle) + sizeof(SKint32));
+
+    bench.run("skVector3Utils::transform(skVector3A)", Count, [] { skVector3Utils::transform(R3A, A4[0], V3A, Count); }, 2 * sizeof(skVector3A));
+
+#ifndef SK_DOUBLE
+    // The batch kernels at each level skSimdDispatch can pick here.
+    const skTraversalRay ray(skRay(skVector3(0, 0, -1), skVector3(skScalar(0.05), skScalar(0.02), 1)));
+
+    for (int l = skSimdDispatch::Scalar; l <= skSimdDispatch::detect(); ++l)
+    {
+        skSimdDispatch::setLevel((skSimdDispatch::Level)l);
+
+        const std::string level = std::string(" [") + skSimdDispatch::name((skSimdDispatch::Level)l) + "]";
+
+        bench.run(("skMath::sinCos" + level).c_str(), Count, [] { skMath::sinCos(Angle, SinR, CosR, Count); }, 3 * sizeof(skScalar));
+        bench.run(("skMath::atan2" + level).c_str(), Count, [] { skMath::atan2(S, SinR, CosR, Count); }, 3 * sizeof(skScalar));
+        bench.run(("skMath::wrapPi" + level).c_str(), Count, [] { skMath::wrapPi(S, Angle, Count); }, 2 * sizeof(skScalar));
+        bench.run(("skBoundingBox3D::hit(boxes)" + level).c_str(), Count, [&] { I[0] = (SKint32)skBoundingBox3D::hit(Hits, S, ray, Box, Count); }, sizeof(skBoundingBox3D));
+        bench.run(("skVector3Utils::madd" + level).c_str(), Count, [] { skVector3Utils::madd(R3, V3, W3, skScalar(0.25), Count); }, 3 * sizeof(skVector3));
+        bench.run(("skVector3Utils::madd(skVector3A)" + level).c_str(), Count, [] { skVector3Utils::madd(R3A, V3A, W3A, skScalar(0.25), Count); }, 3 * sizeof(skVector3A));
+        bench.run(("skVector3Utils::transform" + level).c_str(), Count, [] { skVector3Utils::transform(R3, A4[0], V3, Count); }, 2 * sizeof(skVector3));
+        bench.run(("skBoundingBox3D::compare(points)" + level).c_str(), Count, [] {
+            skBoundingBox3D b;
+            b.compare(V3, Count);
+            S[0] = b.x2;
+        }, sizeof(skVector3));
+    }
+    skSimdDispatch::setLevel(skSimdDispatch::detect());
+#endif
+
+    fprintf(stderr, "checksum %g\n", checksum());
+    return bench.finish("skCoreBench", config().c_str());
+}
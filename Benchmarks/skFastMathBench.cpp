@@ -0,0 +1,128 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "skFastMath.h"
+
+// Compares libm with the scalar and four lane forms of skFastMath.
+
+#if defined(__GNUC__) || defined(__clang__)
+// Keeps the pure libm calls from being hoisted out of the repeat loop.
+#define SK_BENCH_CLOBBER() __asm__ __volatile__("" ::: "memory")
+#else
+#include <intrin.h>
+#define SK_BENCH_CLOBBER() _ReadWriteBarrier()
+#endif
+
+namespace
+{
+    const int Count  = 4096;
+    const int Repeat = 2048;
+
+    float X[Count];
+    float Y[Count];
+    float R[Count];
+
+    void fill(float lo, float hi)
+    {
+        for (int i = 0; i < Count; ++i)
+        {
+            X[i] = lo + (hi - lo) * float(i) / float(Count);
+            Y[i] = hi - (hi - lo) * float(i) / float(Count);
+        }
+    }
+
+    template <typename Op>
+    double time(Op op, int step)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < Repeat; ++r)
+        {
+            for (int i = 0; i < Count; i += step)
+                op(i);
+            SK_BENCH_CLOBBER();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() /
+               ((double)Count * (double)Repeat);
+    }
+
+    template <typename Lib, typename Fast, typename Simd>
+    void run(const char* name, Lib lib, Fast fast, Simd simd)
+    {
+        const double a = time(lib, 1);
+        const double b = time(fast, 1);
+        const double c = time(simd, 4);
+
+        float sum = 0;
+        for (int i = 0; i < Count; ++i)
+            sum += R[i];
+
+        printf("%-8s libm %7.3f  scalar %7.3f  simd %7.3f ns/op  (checksum %g)\n", name, a, b, c, (double)sum);
+    }
+}  // namespace
+
+int main()
+{
+    fill(-10.f, 10.f);
+
+    run(
+        "sin",
+        [](int i) { R[i] = sinf(X[i]); },
+        [](int i) { R[i] = skFastMath::sin(X[i]); },
+        [](int i) { skFastMath::sin(skSimd4f::load(X + i)).store(R + i); });
+
+    run(
+        "cos",
+        [](int i) { R[i] = cosf(X[i]); },
+        [](int i) { R[i] = skFastMath::cos(X[i]); },
+        [](int i) { skFastMath::cos(skSimd4f::load(X + i)).store(R + i); });
+
+    run(
+        "atan2",
+        [](int i) { R[i] = atan2f(Y[i], X[i]); },
+        [](int i) { R[i] = skFastMath::atan2(Y[i], X[i]); },
+        [](int i) { skFastMath::atan2(skSimd4f::load(Y + i), skSimd4f::load(X + i)).store(R + i); });
+
+    run(
+        "exp",
+        [](int i) { R[i] = expf(X[i]); },
+        [](int i) { R[i] = skFastMath::exp(X[i]); },
+        [](int i) { skFastMath::exp(skSimd4f::load(X + i)).store(R + i); });
+
+    fill(0.001f, 100.f);
+
+    run(
+        "log",
+        [](int i) { R[i] = logf(X[i]); },
+        [](int i) { R[i] = skFastMath::log(X[i]); },
+        [](int i) { skFastMath::log(skSimd4f::load(X + i)).store(R + i); });
+
+    run(
+        "rsqrt",
+        [](int i) { R[i] = powf(X[i], -0.5f); },
+        [](int i) { R[i] = skFastMath::rsqrt(X[i]); },
+        [](int i) { skFastMath::rsqrt(skSimd4f::load(X + i)).store(R + i); });
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <chrono>
+#include <cstdio>
+#include "skMatrix4.h"
+
+// Measures the per-call cost of the functions in skMatrix4.inl. Build it
+// once against the compiled library and once with SK_MATH_HEADER_ONLY to
+// compare the out-of-line call overhead with the inlined version.
+// Operations that would be loop invariant feed on their previous result
+// so that the inlined version cannot be hoisted out of the repeat loop.
+
+namespace
+{
+    const int Count  = 1024;
+    const int Repeat = 4096;
+
+    skMatrix4 A[Count];
+    skMatrix4 B[Count];
+    skMatrix4 R[Count];
+
+    void fill()
+    {
+        for (int i = 0; i < Count; ++i)
+        {
+            const skScalar s = skScalar(i % 17) * skScalar(0.125);
+
+            A[i] = skMatrix4(1 + s, s, 0, s, 0, 2, s, 1, s, 0, 3, 2, 0, 0, 0, 1);
+            B[i] = skMatrix4(2, 0, s, 3, s, 1 + s, 0, 1, 0, s, 1, 4, 0, 0, 0, 1);
+            R[i] = A[i];
+        }
+    }
+
+    skScalar checksum()
+    {
+        skScalar r = 0;
+        for (int i = 0; i < Count; ++i)
+            r += R[i].m[0][0] + R[i].m[1][3] + R[i].m[2][2];
+        return r;
+    }
+
+    template <typename Op>
+    void run(const char* name, Op op)
+    {
+        fill();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < Repeat; ++r)
+        {
+            for (int i = 0; i < Count; ++i)
+                op(i);
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        printf("%-12s %8.3f ns/op  (checksum %g)\n",
+               name,
+               ns / ((double)Count * (double)Repeat),
+               (double)checksum());
+    }
+}  // namespace
+
+int main()
+{
+#ifdef SK_MATH_HEADER_ONLY
+    printf("skMatrix4, header only\n");
+#else
+    printf("skMatrix4, compiled\n");
+#endif
+
+    run("operator*", [](int i) { R[i] = A[i] * B[i]; });
+    run("multAssign", [](int i) { R[i].multAssign(A[i], B[i]); });
+    run("inverted", [](int i) { R[i] = A[i].inverted(); });
+    run("transposed", [](int i) { R[i] = R[i].transposed(); });
+    run("det", [](int i) { R[i].m[0][0] += A[i].det(); });
+    run("getTrans", [](int i) { R[i].setTrans(R[i].getTrans() + B[i].getTrans()); });
+    return 0;
+}
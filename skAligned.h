@@ -0,0 +1,132 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skAligned_h_
+#define _skAligned_h_
+
+#include <new>
+#include <vector>
+#include "Utils/Config/skConfig.h"
+
+/// <summary>
+/// The size of a cache line on the targets the library is tuned for.
+/// </summary>
+constexpr SKsize skCacheLine = 64;
+
+/// <summary>
+/// Allocates size bytes at a multiple of align, a power of two.
+/// Release the memory with skAlignedFree and the same align.
+/// </summary>
+SK_INLINE void* skAlignedAlloc(SKsize size, SKsize align)
+{
+    return ::operator new(size, std::align_val_t(align));
+}
+
+SK_INLINE void skAlignedFree(void* p, SKsize align)
+{
+    ::operator delete(p, std::align_val_t(align));
+}
+
+/// <summary>
+/// Standard allocator that places every block at a multiple of Align,
+/// so that SIMD loads over the block never straddle a cache line.
+/// </summary>
+template <typename T, SKsize Align = skCacheLine>
+class skAlignedAllocator
+{
+public:
+    static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+    static_assert(Align >= alignof(T), "Align must not weaken the alignment of T");
+
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef skAlignedAllocator<U, Align> other;
+    };
+
+    skAlignedAllocator() = default;
+
+    template <typename U>
+    constexpr skAlignedAllocator(const skAlignedAllocator<U, Align>&) noexcept
+    {
+    }
+
+    T* allocate(SKsize n)
+    {
+        return static_cast<T*>(skAlignedAlloc(n * sizeof(T), Align));
+    }
+
+    void deallocate(T* p, SKsize)
+    {
+        skAlignedFree(p, Align);
+    }
+
+    template <typename U>
+    constexpr bool operator==(const skAlignedAllocator<U, Align>&) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    constexpr bool operator!=(const skAlignedAllocator<U, Align>&) const noexcept
+    {
+        return false;
+    }
+};
+
+/// <summary>
+/// std::vector whose storage starts at a multiple of Align, a cache
+/// line by default.
+/// </summary>
+template <typename T, SKsize Align = skCacheLine>
+using skAlignedArray = std::vector<T, skAlignedAllocator<T, Align>>;
+
+/// <summary>
+/// T placed at a multiple of Align, a power of two. The size of the
+/// type rounds up to Align, so arrays of it keep every element aligned.
+/// It converts to and from T, and is the base of the A variants such
+/// as skMatrix4A and skQuaternionA.
+/// </summary>
+template <typename T, SKsize Align>
+class alignas(Align) skAligned : public T
+{
+public:
+    static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+
+    using T::T;
+
+    skAligned() = default;
+
+    constexpr skAligned(const T& v) :
+        T(v)
+    {
+    }
+
+    skAligned& operator=(const T& v)
+    {
+        T::operator=(v);
+        return *this;
+    }
+};
+
+#endif  //_skAligned_h_
@@ -0,0 +1,342 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skArrayFile.h"
+#include <cstdio>
+#include <cstring>
+
+#if SK_PLATFORM == SK_PLATFORM_WIN32
+#define WIN32_LEAN_AND_MEAN 1
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(skArrayFile::Header) == 32, "the header is part of the file format");
+static_assert(sizeof(skArrayFile::Entry) == 32, "the entries are part of the file format");
+
+namespace
+{
+    SKuint64 alignUp(SKuint64 v)
+    {
+        return (v + skArrayFile::Alignment - 1) & ~SKuint64(skArrayFile::Alignment - 1);
+    }
+
+#if SK_ENDIAN == SK_ENDIAN_BIG
+    // Reverses the bytes of each of the count values of width bytes at p.
+    void swapBytes(void* p, SKsize count, SKsize width)
+    {
+        SKubyte* b = static_cast<SKubyte*>(p);
+        for (SKsize i = 0; i < count; ++i, b += width)
+        {
+            for (SKsize lo = 0, hi = width - 1; lo < hi; ++lo, --hi)
+            {
+                const SKubyte t = b[lo];
+                b[lo]           = b[hi];
+                b[hi]           = t;
+            }
+        }
+    }
+
+    template <typename T>
+    void swapField(T& v)
+    {
+        swapBytes(&v, 1, sizeof(T));
+    }
+
+    void swapHeader(skArrayFile::Header& h)
+    {
+        swapField(h.magic);
+        swapField(h.version);
+        swapField(h.headerSize);
+        swapField(h.arrayCount);
+        swapField(h.reserved);
+        swapField(h.fileSize);
+        swapField(h.reserved2);
+    }
+
+    void swapEntry(skArrayFile::Entry& e)
+    {
+        swapField(e.id);
+        swapField(e.type);
+        swapField(e.scalarSize);
+        swapField(e.elementSize);
+        swapField(e.reserved);
+        swapField(e.count);
+        swapField(e.offset);
+    }
+#endif
+
+    bool writeBytes(FILE* fp, const void* data, SKsize size)
+    {
+        return size == 0 || fwrite(data, 1, size, fp) == size;
+    }
+
+    // Writes size bytes of scalars of scalarSize bytes in little endian.
+    bool writeScalars(FILE* fp, const void* data, SKsize size, SKsize scalarSize)
+    {
+#if SK_ENDIAN == SK_ENDIAN_BIG
+        SKubyte        buffer[4096];
+        const SKubyte* src = static_cast<const SKubyte*>(data);
+        while (size > 0)
+        {
+            const SKsize n = size < sizeof(buffer) ? size : sizeof(buffer);
+            memcpy(buffer, src, n);
+            swapBytes(buffer, n / scalarSize, scalarSize);
+            if (!writeBytes(fp, buffer, n))
+                return false;
+            src += n;
+            size -= n;
+        }
+        return true;
+#else
+        (void)scalarSize;
+        return writeBytes(fp, data, size);
+#endif
+    }
+}
+
+skArrayFile::skArrayFile() :
+    m_data(nullptr),
+    m_size(0),
+    m_copy(nullptr),
+    m_mapping(nullptr)
+{
+}
+
+skArrayFile::~skArrayFile()
+{
+    close();
+}
+
+bool skArrayFile::open(const char* path)
+{
+    close();
+
+#if SK_ENDIAN == SK_ENDIAN_BIG
+    // The arrays have to be swapped, so they are read into memory.
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return false;
+
+    long size = -1;
+    if (fseek(fp, 0, SEEK_END) == 0)
+        size = ftell(fp);
+
+    if (size >= (long)sizeof(Header) && fseek(fp, 0, SEEK_SET) == 0)
+    {
+        m_copy = new SKubyte[(SKsize)size];
+        if (fread(m_copy, 1, (SKsize)size, fp) == (SKsize)size)
+        {
+            m_data = m_copy;
+            m_size = (SKsize)size;
+        }
+    }
+    fclose(fp);
+
+    if (!m_data)
+    {
+        close();
+        return false;
+    }
+
+    Header& h = *reinterpret_cast<Header*>(m_copy);
+    swapHeader(h);
+    if (h.arrayCount <= (m_size - sizeof(Header)) / sizeof(Entry))
+    {
+        Entry* e = reinterpret_cast<Entry*>(m_copy + sizeof(Header));
+        for (SKuint32 i = 0; i < h.arrayCount; ++i)
+            swapEntry(e[i]);
+    }
+#elif SK_PLATFORM == SK_PLATFORM_WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    HANDLE        mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (!mapping)
+        return false;
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_data    = static_cast<const SKubyte*>(view);
+    m_size    = (SKsize)size.QuadPart;
+#else
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    void*       view = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        view = mmap(nullptr, (SKsize)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (view == MAP_FAILED)
+        return false;
+
+    m_mapping = view;
+    m_data    = static_cast<const SKubyte*>(view);
+    m_size    = (SKsize)st.st_size;
+#endif
+
+    if (!validate())
+    {
+        close();
+        return false;
+    }
+
+#if SK_ENDIAN == SK_ENDIAN_BIG
+    for (SKuint32 i = 0; i < arrayCount(); ++i)
+    {
+        const Entry& e = entry(i);
+        swapBytes(m_copy + e.offset, (SKsize)(e.count * e.elementSize / e.scalarSize), e.scalarSize);
+    }
+#endif
+    return true;
+}
+
+void skArrayFile::close()
+{
+#if SK_PLATFORM == SK_PLATFORM_WIN32
+    if (m_mapping)
+    {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+    }
+#else
+    if (m_mapping)
+        munmap(m_mapping, m_size);
+#endif
+    delete[] m_copy;
+
+    m_data    = nullptr;
+    m_size    = 0;
+    m_copy    = nullptr;
+    m_mapping = nullptr;
+}
+
+SKsize skArrayFile::find(SKuint32 id) const
+{
+    for (SKuint32 i = 0; i < arrayCount(); ++i)
+    {
+        if (entry(i).id == id)
+            return i;
+    }
+    return NotFound;
+}
+
+bool skArrayFile::validate() const
+{
+    if (m_size < sizeof(Header))
+        return false;
+
+    const Header& h = header();
+    if (h.magic != Magic || h.version == 0 || h.version > Version || h.headerSize != sizeof(Header) || h.fileSize != m_size)
+        return false;
+
+    if (h.arrayCount > (m_size - sizeof(Header)) / sizeof(Entry))
+        return false;
+
+    for (SKuint32 i = 0; i < h.arrayCount; ++i)
+    {
+        const Entry& e = entry(i);
+        if (e.scalarSize != sizeof(float) && e.scalarSize != sizeof(double))
+            return false;
+        if (e.elementSize == 0 || e.elementSize % e.scalarSize != 0)
+            return false;
+        if (e.offset % Alignment != 0 || e.offset > m_size)
+            return false;
+        if (e.count > (m_size - e.offset) / e.elementSize)
+            return false;
+    }
+    return true;
+}
+
+bool skArrayFileWriter::save(const char* path) const
+{
+    typedef skArrayFile::Header Header;
+    typedef skArrayFile::Entry  Entry;
+
+    // Lay the arrays out first, so the file is written front to back.
+    std::vector<Entry> table(m_arrays.size());
+
+    SKuint64 end = sizeof(Header) + table.size() * sizeof(Entry);
+    for (SKsize i = 0; i < table.size(); ++i)
+    {
+        table[i]        = m_arrays[i].entry;
+        table[i].offset = alignUp(end);
+        end             = table[i].offset + table[i].count * table[i].elementSize;
+    }
+
+    Header header = {};
+
+    header.magic      = skArrayFile::Magic;
+    header.version    = skArrayFile::Version;
+    header.headerSize = sizeof(Header);
+    header.arrayCount = (SKuint32)table.size();
+    header.fileSize   = end;
+
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+        return false;
+
+    SKuint64 at = sizeof(Header) + table.size() * sizeof(Entry);
+
+#if SK_ENDIAN == SK_ENDIAN_BIG
+    std::vector<Entry> swapped(table);
+    for (Entry& e : swapped)
+        swapEntry(e);
+    swapHeader(header);
+    bool ok = writeBytes(fp, &header, sizeof(Header)) && writeBytes(fp, swapped.data(), swapped.size() * sizeof(Entry));
+#else
+    bool ok = writeBytes(fp, &header, sizeof(Header)) && writeBytes(fp, table.data(), table.size() * sizeof(Entry));
+#endif
+
+    static const SKubyte zeros[skArrayFile::Alignment] = {};
+
+    for (SKsize i = 0; ok && i < table.size(); ++i)
+    {
+        const Entry& e = table[i];
+
+        ok = writeBytes(fp, zeros, (SKsize)(e.offset - at)) &&
+             writeScalars(fp, m_arrays[i].data, (SKsize)(e.count * e.elementSize), e.scalarSize);
+        at = e.offset + e.count * e.elementSize;
+    }
+
+    if (fclose(fp) != 0)
+        ok = false;
+    return ok;
+}
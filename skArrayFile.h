@@ -0,0 +1,260 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skArrayFile_h_
+#define _skArrayFile_h_
+
+#include <vector>
+#include "skColor.h"
+#include "skMatrix3.h"
+#include "skMatrix4.h"
+#include "skQuaternion.h"
+#include "skSpan.h"
+#include "skVector2.h"
+#include "skVector3.h"
+#include "skVector4.h"
+
+/// <summary>
+/// Read only view of a binary file of math arrays, written by
+/// skArrayFileWriter. The file is mapped into memory and view() points
+/// straight into the mapping, so loading costs no parsing and no copies.
+///
+/// Layout, little endian throughout:
+///   Header             32 bytes, arrayCount entries follow it
+///   Entry[arrayCount]  32 bytes each
+///   array data         each array starts at a multiple of Alignment
+///
+/// Arrays hold the elements exactly as they are laid out in memory, so
+/// a view needs the precision the file was written with. A big endian
+/// host reads the file into memory and swaps it instead of mapping it.
+/// </summary>
+class skArrayFile
+{
+public:
+    static constexpr SKuint32 Magic     = 0x414D4B53;  // "SKMA"
+    static constexpr SKuint16 Version   = 1;
+    static constexpr SKsize   Alignment = 64;
+    static constexpr SKsize   NotFound  = ~SKsize(0);
+
+    enum Type
+    {
+        Scalar = 1,
+        Vector2,
+        Vector3,
+        Vector4,
+        Quaternion,
+        Matrix3,
+        Matrix4,
+        Color,
+    };
+
+    struct Header
+    {
+        SKuint32 magic;
+        SKuint16 version;
+        SKuint16 headerSize;
+        SKuint32 arrayCount;
+        SKuint32 reserved;
+        SKuint64 fileSize;
+        SKuint64 reserved2;
+    };
+
+    /// <summary>
+    /// Describes one array. id is chosen by the writer to find the
+    /// array again, and offset is from the start of the file.
+    /// </summary>
+    struct Entry
+    {
+        SKuint32 id;
+        SKuint16 type;
+        SKuint16 scalarSize;
+        SKuint32 elementSize;
+        SKuint32 reserved;
+        SKuint64 count;
+        SKuint64 offset;
+    };
+
+    /// <summary>
+    /// The Type of the element type T.
+    /// </summary>
+    template <typename T>
+    struct TypeOf;
+
+private:
+    const SKubyte* m_data;
+    SKsize         m_size;
+    SKubyte*       m_copy;
+    void*          m_mapping;
+
+public:
+    skArrayFile();
+    ~skArrayFile();
+
+    skArrayFile(const skArrayFile&)            = delete;
+    skArrayFile& operator=(const skArrayFile&) = delete;
+
+    /// <summary>
+    /// Maps the file at path and checks its header and array table.
+    /// Returns false when the file cannot be read, is not an array file
+    /// of a known version, or its table points outside the file.
+    /// </summary>
+    bool open(const char* path);
+
+    void close();
+
+    bool isOpen() const
+    {
+        return m_data != nullptr;
+    }
+
+    SKuint32 arrayCount() const
+    {
+        return m_data ? header().arrayCount : 0;
+    }
+
+    const Entry& entry(SKuint32 index) const
+    {
+        return entries()[index];
+    }
+
+    /// <summary>
+    /// Returns the index of the first array with id, or NotFound.
+    /// </summary>
+    SKsize find(SKuint32 id) const;
+
+    /// <summary>
+    /// Returns the elements of array index. The span is empty when the
+    /// array does not hold T in the current skScalar precision, and is
+    /// valid until close().
+    /// </summary>
+    template <typename T>
+    skSpan<const T> view(SKuint32 index) const
+    {
+        const Entry& e = entry(index);
+        if (e.type != TypeOf<T>::value || e.scalarSize != sizeof(skScalar) || e.elementSize != sizeof(T))
+            return skSpan<const T>();
+        return skSpan<const T>(reinterpret_cast<const T*>(m_data + e.offset), (SKsize)e.count);
+    }
+
+private:
+    const Header& header() const
+    {
+        return *reinterpret_cast<const Header*>(m_data);
+    }
+
+    const Entry* entries() const
+    {
+        return reinterpret_cast<const Entry*>(m_data + sizeof(Header));
+    }
+
+    bool validate() const;
+};
+
+template <>
+struct skArrayFile::TypeOf<skScalar>
+{
+    static constexpr Type value = Scalar;
+};
+
+template <>
+struct skArrayFile::TypeOf<skVector2>
+{
+    static constexpr Type value = Vector2;
+};
+
+template <>
+struct skArrayFile::TypeOf<skVector3>
+{
+    static constexpr Type value = Vector3;
+};
+
+template <>
+struct skArrayFile::TypeOf<skVector4>
+{
+    static constexpr Type value = Vector4;
+};
+
+template <>
+struct skArrayFile::TypeOf<skQuaternion>
+{
+    static constexpr Type value = Quaternion;
+};
+
+template <>
+struct skArrayFile::TypeOf<skMatrix3>
+{
+    static constexpr Type value = Matrix3;
+};
+
+template <>
+struct skArrayFile::TypeOf<skMatrix4>
+{
+    static constexpr Type value = Matrix4;
+};
+
+template <>
+struct skArrayFile::TypeOf<skColor>
+{
+    static constexpr Type value = Color;
+};
+
+/// <summary>
+/// Collects arrays and writes them as one skArrayFile. add() only keeps
+/// the pointer, so the data must stay alive until save().
+/// </summary>
+class skArrayFileWriter
+{
+private:
+    struct Source
+    {
+        const void*        data;
+        skArrayFile::Entry entry;
+    };
+
+    std::vector<Source> m_arrays;
+
+public:
+    template <typename T>
+    void add(SKuint32 id, const T* data, SKsize count)
+    {
+        skArrayFile::Entry e = {};
+
+        e.id          = id;
+        e.type        = skArrayFile::TypeOf<T>::value;
+        e.scalarSize  = sizeof(skScalar);
+        e.elementSize = sizeof(T);
+        e.count       = count;
+        m_arrays.push_back({data, e});
+    }
+
+    void clear()
+    {
+        m_arrays.clear();
+    }
+
+    /// <summary>
+    /// Writes the header, the table and the arrays in one pass. Returns
+    /// false when the file cannot be written.
+    /// </summary>
+    bool save(const char* path) const;
+};
+
+#endif  //_skArrayFile_h_
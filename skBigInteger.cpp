@@ -0,0 +1,785 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skBigInteger.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include "skRational.h"
+
+// Pooled limb blocks come in power of two sizes starting at four limbs.
+const SKuint32 SK_BIG_POOL_CLASSES = 20;
+const SKuint32 SK_BIG_POOL_DEPTH   = 32;
+const SKuint64 SK_BIG_SMALL_MAX    = 0x7FFFFFFFFFFFFFFFULL;
+
+struct skBigIntegerPool
+{
+    SKuint32* blocks[SK_BIG_POOL_CLASSES][SK_BIG_POOL_DEPTH];
+    SKuint32  count[SK_BIG_POOL_CLASSES];
+    bool      closed;
+};
+
+// Trivially destructible so that it stays usable while other thread-local
+// or static objects are being torn down; the guard below empties it.
+static thread_local skBigIntegerPool skBigPool;
+
+class skBigIntegerPoolGuard
+{
+public:
+    ~skBigIntegerPoolGuard()
+    {
+        for (SKuint32 c = 0; c < SK_BIG_POOL_CLASSES; ++c)
+        {
+            while (skBigPool.count[c] > 0)
+                free(skBigPool.blocks[c][--skBigPool.count[c]]);
+        }
+        skBigPool.closed = true;
+    }
+};
+
+static SKuint32 skBigPoolClass(SKuint32 limbs)
+{
+    SKuint32 c = 0;
+    while ((SKuint32(4) << c) < limbs)
+        ++c;
+    return c;
+}
+
+static SKuint32* skBigAllocate(SKuint32 limbs, SKuint32& capacity)
+{
+    static thread_local skBigIntegerPoolGuard guard;
+    (void)guard;
+
+    const SKuint32 c = skBigPoolClass(limbs);
+    capacity         = SKuint32(4) << c;
+
+    if (c < SK_BIG_POOL_CLASSES && skBigPool.count[c] > 0)
+        return skBigPool.blocks[c][--skBigPool.count[c]];
+    return (SKuint32*)malloc(capacity * sizeof(SKuint32));
+}
+
+static void skBigRelease(SKuint32* limbs, SKuint32 capacity)
+{
+    const SKuint32 c = skBigPoolClass(capacity);
+    if (!skBigPool.closed && c < SK_BIG_POOL_CLASSES && skBigPool.count[c] < SK_BIG_POOL_DEPTH)
+        skBigPool.blocks[c][skBigPool.count[c]++] = limbs;
+    else
+        free(limbs);
+}
+
+static SK_INLINE SKuint64 skBigMagnitude(SKint64 v)
+{
+    return v < 0 ? SKuint64(0) - SKuint64(v) : SKuint64(v);
+}
+
+static SK_INLINE bool skBigAddSmall(SKint64& r, SKint64 a, SKint64 b)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_add_overflow(a, b, &r) && skBigMagnitude(r) <= SK_BIG_SMALL_MAX;
+#else
+    if (b > 0 ? a > SKint64(SK_BIG_SMALL_MAX) - b : a < -SKint64(SK_BIG_SMALL_MAX) - b)
+        return false;
+    r = a + b;
+    return true;
+#endif
+}
+
+static SK_INLINE bool skBigMulSmall(SKint64& r, SKint64 a, SKint64 b)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_mul_overflow(a, b, &r) && skBigMagnitude(r) <= SK_BIG_SMALL_MAX;
+#else
+    const SKuint64 ua = skBigMagnitude(a), ub = skBigMagnitude(b);
+    if (ub != 0 && ua > SK_BIG_SMALL_MAX / ub)
+        return false;
+    r = a * b;
+    return true;
+#endif
+}
+
+static SK_INLINE SKuint32 skBigTrim(const SKuint32* a, SKuint32 len)
+{
+    while (len > 0 && a[len - 1] == 0)
+        --len;
+    return len;
+}
+
+static SK_INLINE int skBigLeadingZeros(SKuint32 v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clz(v);
+#else
+    int r = 0;
+    while ((v & 0x80000000) == 0)
+    {
+        v <<= 1;
+        ++r;
+    }
+    return r;
+#endif
+}
+
+static int skBigCompareMag(const SKuint32* a, SKuint32 an, const SKuint32* b, SKuint32 bn)
+{
+    if (an != bn)
+        return an < bn ? -1 : 1;
+    while (an-- > 0)
+    {
+        if (a[an] != b[an])
+            return a[an] < b[an] ? -1 : 1;
+    }
+    return 0;
+}
+
+static SKuint32 skBigAddMag(SKuint32* r, const SKuint32* a, SKuint32 an, const SKuint32* b, SKuint32 bn)
+{
+    if (an < bn)
+    {
+        const SKuint32* t = a;
+        a                 = b;
+        b                 = t;
+
+        const SKuint32 tn = an;
+        an                = bn;
+        bn                = tn;
+    }
+
+    SKuint64 carry = 0;
+    SKuint32 i     = 0;
+    for (; i < bn; ++i)
+    {
+        carry += SKuint64(a[i]) + b[i];
+        r[i] = SKuint32(carry);
+        carry >>= 32;
+    }
+    for (; i < an; ++i)
+    {
+        carry += a[i];
+        r[i] = SKuint32(carry);
+        carry >>= 32;
+    }
+    r[an] = SKuint32(carry);
+    return skBigTrim(r, an + 1);
+}
+
+// |a| >= |b|
+static SKuint32 skBigSubMag(SKuint32* r, const SKuint32* a, SKuint32 an, const SKuint32* b, SKuint32 bn)
+{
+    SKint64  borrow = 0;
+    SKuint32 i      = 0;
+    for (; i < bn; ++i)
+    {
+        const SKint64 t = SKint64(a[i]) - b[i] - borrow;
+        r[i]            = SKuint32(t);
+        borrow          = t < 0 ? 1 : 0;
+    }
+    for (; i < an; ++i)
+    {
+        const SKint64 t = SKint64(a[i]) - borrow;
+        r[i]            = SKuint32(t);
+        borrow          = t < 0 ? 1 : 0;
+    }
+    return skBigTrim(r, an);
+}
+
+static SKuint32 skBigMulMag(SKuint32* r, const SKuint32* a, SKuint32 an, const SKuint32* b, SKuint32 bn)
+{
+    memset(r, 0, (an + bn) * sizeof(SKuint32));
+
+    for (SKuint32 i = 0; i < an; ++i)
+    {
+        const SKuint64 ai    = a[i];
+        SKuint64       carry = 0;
+        for (SKuint32 j = 0; j < bn; ++j)
+        {
+            carry += ai * b[j] + r[i + j];
+            r[i + j] = SKuint32(carry);
+            carry >>= 32;
+        }
+        r[i + bn] = SKuint32(carry);
+    }
+    return skBigTrim(r, an + bn);
+}
+
+static SKuint32 skBigDivSmall(SKuint32* q, const SKuint32* u, SKuint32 m, SKuint32 v)
+{
+    SKuint64 rem = 0;
+    for (SKuint32 i = m; i-- > 0;)
+    {
+        const SKuint64 cur = (rem << 32) | u[i];
+        q[i]               = SKuint32(cur / v);
+        rem                = cur % v;
+    }
+    return SKuint32(rem);
+}
+
+// Knuth, TAOCP Vol. 2, 4.3.1 Algorithm D. Requires m >= n >= 2 and a
+// non-zero most significant divisor limb. q receives m - n + 1 limbs,
+// r receives n limbs, un and vn are scratch of m + 1 and n limbs.
+static void skBigDivKnuth(SKuint32*       q,
+                          SKuint32*       r,
+                          const SKuint32* u,
+                          SKuint32        m,
+                          const SKuint32* v,
+                          SKuint32        n,
+                          SKuint32*       un,
+                          SKuint32*       vn)
+{
+    const SKuint64 base = SKuint64(1) << 32;
+    const int      s    = skBigLeadingZeros(v[n - 1]);
+
+    for (SKuint32 i = n - 1; i > 0; --i)
+        vn[i] = (v[i] << s) | SKuint32(SKuint64(v[i - 1]) >> (32 - s));
+    vn[0] = v[0] << s;
+
+    un[m] = SKuint32(SKuint64(u[m - 1]) >> (32 - s));
+    for (SKuint32 i = m - 1; i > 0; --i)
+        un[i] = (u[i] << s) | SKuint32(SKuint64(u[i - 1]) >> (32 - s));
+    un[0] = u[0] << s;
+
+    for (SKint64 j = SKint64(m) - SKint64(n); j >= 0; --j)
+    {
+        const SKuint64 num  = (SKuint64(un[j + n]) << 32) | un[j + n - 1];
+        SKuint64       qhat = num / vn[n - 1];
+        SKuint64       rhat = num - qhat * vn[n - 1];
+
+        while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2]))
+        {
+            --qhat;
+            rhat += vn[n - 1];
+            if (rhat >= base)
+                break;
+        }
+
+        SKint64 k = 0, t;
+        for (SKuint32 i = 0; i < n; ++i)
+        {
+            const SKuint64 p = qhat * vn[i];
+
+            t         = SKint64(un[i + j]) - k - SKint64(p & 0xFFFFFFFF);
+            un[i + j] = SKuint32(t);
+            k         = SKint64(p >> 32) - (t >> 32);
+        }
+        t         = SKint64(un[j + n]) - k;
+        un[j + n] = SKuint32(t);
+        q[j]      = SKuint32(qhat);
+
+        if (t < 0)
+        {
+            // qhat was one too large, add the divisor back.
+            --q[j];
+            SKuint64 c = 0;
+            for (SKuint32 i = 0; i < n; ++i)
+            {
+                c += SKuint64(un[i + j]) + vn[i];
+                un[i + j] = SKuint32(c);
+                c >>= 32;
+            }
+            un[j + n] += SKuint32(c);
+        }
+    }
+
+    for (SKuint32 i = 0; i + 1 < n; ++i)
+        r[i] = (un[i] >> s) | SKuint32(SKuint64(un[i + 1]) << (32 - s));
+    r[n - 1] = un[n - 1] >> s;
+}
+
+/// <summary>
+/// Read-only limb view of either representation.
+/// </summary>
+class skBigIntegerView
+{
+public:
+    explicit skBigIntegerView(const skBigInteger& v)
+    {
+        if (v.isSmall())
+        {
+            const SKuint64 mag = skBigMagnitude(v.m_small);
+
+            m_tmp[0] = SKuint32(mag);
+            m_tmp[1] = SKuint32(mag >> 32);
+            limbs    = m_tmp;
+            size     = skBigTrim(m_tmp, 2);
+            negative = v.m_small < 0;
+        }
+        else
+        {
+            limbs    = v.m_limbs;
+            size     = v.m_size;
+            negative = v.m_negative;
+        }
+    }
+
+    skBigIntegerView(const skBigIntegerView&) = delete;
+    skBigIntegerView& operator=(const skBigIntegerView&) = delete;
+
+    const SKuint32* limbs;
+    SKuint32        size;
+    bool            negative;
+
+private:
+    SKuint32 m_tmp[2]{};
+};
+
+skBigInteger::skBigInteger() :
+    m_small(0),
+    m_limbs(nullptr),
+    m_size(0),
+    m_capacity(0),
+    m_negative(false)
+{
+}
+
+skBigInteger::skBigInteger(SKint64 v) :
+    m_small(v),
+    m_limbs(nullptr),
+    m_size(0),
+    m_capacity(0),
+    m_negative(false)
+{
+    if (skBigMagnitude(v) > SK_BIG_SMALL_MAX)
+    {
+        const SKuint32 mag[2] = {0, 0x80000000};
+        assign(mag, 2, true);
+    }
+}
+
+skBigInteger::skBigInteger(const skBigInteger& o) :
+    m_small(o.m_small),
+    m_limbs(nullptr),
+    m_size(0),
+    m_capacity(0),
+    m_negative(false)
+{
+    if (!o.isSmall())
+        assign(o.m_limbs, o.m_size, o.m_negative);
+}
+
+skBigInteger::skBigInteger(skBigInteger&& o) noexcept :
+    m_small(o.m_small),
+    m_limbs(o.m_limbs),
+    m_size(o.m_size),
+    m_capacity(o.m_capacity),
+    m_negative(o.m_negative)
+{
+    o.m_small = 0;
+    o.m_limbs = nullptr;
+    o.m_size = o.m_capacity = 0;
+    o.m_negative            = false;
+}
+
+skBigInteger::~skBigInteger()
+{
+    release();
+}
+
+skBigInteger& skBigInteger::operator=(const skBigInteger& o)
+{
+    if (this != &o)
+    {
+        if (o.isSmall())
+        {
+            release();
+            m_small = o.m_small;
+        }
+        else
+            assign(o.m_limbs, o.m_size, o.m_negative);
+    }
+    return *this;
+}
+
+skBigInteger& skBigInteger::operator=(skBigInteger&& o) noexcept
+{
+    if (this != &o)
+    {
+        release();
+        m_small    = o.m_small;
+        m_limbs    = o.m_limbs;
+        m_size     = o.m_size;
+        m_capacity = o.m_capacity;
+        m_negative = o.m_negative;
+
+        o.m_small = 0;
+        o.m_limbs = nullptr;
+        o.m_size = o.m_capacity = 0;
+        o.m_negative            = false;
+    }
+    return *this;
+}
+
+void skBigInteger::release()
+{
+    if (m_limbs)
+        skBigRelease(m_limbs, m_capacity);
+    m_limbs    = nullptr;
+    m_size     = 0;
+    m_capacity = 0;
+    m_negative = false;
+    m_small    = 0;
+}
+
+void skBigInteger::assign(const SKuint32* mag, SKuint32 len, bool negative)
+{
+    len = skBigTrim(mag, len);
+    if (len <= 2)
+    {
+        const SKuint64 v = len == 0 ? 0 : len == 1 ? mag[0] : (SKuint64(mag[1]) << 32) | mag[0];
+        if (v <= SK_BIG_SMALL_MAX)
+        {
+            release();
+            m_small = negative ? -SKint64(v) : SKint64(v);
+            return;
+        }
+    }
+
+    if (!m_limbs || m_capacity < len)
+    {
+        SKuint32  capacity;
+        SKuint32* limbs = skBigAllocate(len, capacity);
+        release();
+        m_limbs    = limbs;
+        m_capacity = capacity;
+    }
+
+    memmove(m_limbs, mag, len * sizeof(SKuint32));
+    m_size     = len;
+    m_negative = negative;
+    m_small    = 0;
+}
+
+void skBigInteger::adopt(SKuint32* mag, SKuint32 len, SKuint32 capacity, bool negative)
+{
+    len = skBigTrim(mag, len);
+    if (len <= 2)
+    {
+        const SKuint64 v = len == 0 ? 0 : len == 1 ? mag[0] : (SKuint64(mag[1]) << 32) | mag[0];
+        if (v <= SK_BIG_SMALL_MAX)
+        {
+            skBigRelease(mag, capacity);
+            release();
+            m_small = negative ? -SKint64(v) : SKint64(v);
+            return;
+        }
+    }
+
+    release();
+    m_limbs    = mag;
+    m_size     = len;
+    m_capacity = capacity;
+    m_negative = negative;
+}
+
+int skBigInteger::sign() const
+{
+    if (isSmall())
+        return m_small > 0 ? 1 : m_small < 0 ? -1 : 0;
+    return m_negative ? -1 : 1;
+}
+
+SKuint32 skBigInteger::size() const
+{
+    if (!isSmall())
+        return m_size;
+
+    const SKuint64 mag = skBigMagnitude(m_small);
+    return mag == 0 ? 0 : mag >> 32 ? 2 : 1;
+}
+
+void skBigInteger::negate()
+{
+    if (isSmall())
+        m_small = -m_small;
+    else
+        m_negative = !m_negative;
+}
+
+skBigInteger skBigInteger::operator-() const
+{
+    skBigInteger r(*this);
+    r.negate();
+    return r;
+}
+
+double skBigInteger::toDouble(int& exponent) const
+{
+    if (isSmall())
+    {
+        exponent = 0;
+        return (double)m_small;
+    }
+
+    // The top three limbs carry more bits than a double can hold.
+    const SKuint32  n = m_size < 3 ? m_size : 3;
+    const SKuint32* p = m_limbs + m_size - n;
+
+    double v = 0;
+    for (SKuint32 i = n; i-- > 0;)
+        v = v * 4294967296.0 + (double)p[i];
+
+    exponent = int(32 * (m_size - n));
+    return m_negative ? -v : v;
+}
+
+double skBigInteger::toDouble() const
+{
+    int          e;
+    const double m = toDouble(e);
+    return ldexp(m, e);
+}
+
+int skBigInteger::compare(const skBigInteger& a, const skBigInteger& b)
+{
+    if (a.isSmall() && b.isSmall())
+        return a.m_small < b.m_small ? -1 : a.m_small > b.m_small ? 1 : 0;
+
+    const int sa = a.sign(), sb = b.sign();
+    if (sa != sb)
+        return sa < sb ? -1 : 1;
+
+    const skBigIntegerView va(a), vb(b);
+
+    const int c = skBigCompareMag(va.limbs, va.size, vb.limbs, vb.size);
+    return sa < 0 ? -c : c;
+}
+
+void skBigInteger::add(skBigInteger& r, const skBigInteger& a, const skBigInteger& b)
+{
+    if (a.isSmall() && b.isSmall())
+    {
+        SKint64 s;
+        if (skBigAddSmall(s, a.m_small, b.m_small))
+        {
+            r.release();
+            r.m_small = s;
+            return;
+        }
+    }
+
+    const skBigIntegerView va(a), vb(b);
+
+    SKuint32  capacity;
+    SKuint32* out = skBigAllocate(skMax(va.size, vb.size) + 1, capacity);
+    SKuint32  len;
+    bool      neg;
+
+    if (va.negative == vb.negative)
+    {
+        len = skBigAddMag(out, va.limbs, va.size, vb.limbs, vb.size);
+        neg = va.negative;
+    }
+    else if (skBigCompareMag(va.limbs, va.size, vb.limbs, vb.size) >= 0)
+    {
+        len = skBigSubMag(out, va.limbs, va.size, vb.limbs, vb.size);
+        neg = va.negative;
+    }
+    else
+    {
+        len = skBigSubMag(out, vb.limbs, vb.size, va.limbs, va.size);
+        neg = vb.negative;
+    }
+
+    r.adopt(out, len, capacity, neg && len > 0);
+}
+
+void skBigInteger::sub(skBigInteger& r, const skBigInteger& a, const skBigInteger& b)
+{
+    if (b.isSmall())
+    {
+        add(r, a, skBigInteger(-b.m_small));
+        return;
+    }
+
+    skBigInteger nb(b);
+    nb.negate();
+    add(r, a, nb);
+}
+
+void skBigInteger::mul(skBigInteger& r, const skBigInteger& a, const skBigInteger& b)
+{
+    if (a.isSmall() && b.isSmall())
+    {
+        SKint64 p;
+        if (skBigMulSmall(p, a.m_small, b.m_small))
+        {
+            r.release();
+            r.m_small = p;
+            return;
+        }
+    }
+
+    const skBigIntegerView va(a), vb(b);
+
+    if (va.size == 0 || vb.size == 0)
+    {
+        r.release();
+        return;
+    }
+
+    SKuint32        capacity;
+    SKuint32*       out = skBigAllocate(va.size + vb.size, capacity);
+    const SKuint32  len = skBigMulMag(out, va.limbs, va.size, vb.limbs, vb.size);
+    r.adopt(out, len, capacity, va.negative != vb.negative);
+}
+
+bool skBigInteger::divMod(skBigInteger& q, skBigInteger& r, const skBigInteger& a, const skBigInteger& b)
+{
+    if (b.isZero())
+        return false;
+
+    if (a.isSmall() && b.isSmall())
+    {
+        const SKint64 qs = a.m_small / b.m_small;
+        const SKint64 rs = a.m_small % b.m_small;
+        q.release();
+        r.release();
+        q.m_small = qs;
+        r.m_small = rs;
+        return true;
+    }
+
+    const skBigIntegerView va(a), vb(b);
+
+    if (skBigCompareMag(va.limbs, va.size, vb.limbs, vb.size) < 0)
+    {
+        r = a;
+        q.release();
+        return true;
+    }
+
+    const bool qneg = va.negative != vb.negative;
+    const bool rneg = va.negative;
+
+    SKuint32  qcap, rcap;
+    SKuint32* qout = skBigAllocate(va.size - vb.size + 1, qcap);
+    SKuint32* rout = skBigAllocate(vb.size, rcap);
+
+    if (vb.size == 1)
+    {
+        rout[0] = skBigDivSmall(qout, va.limbs, va.size, vb.limbs[0]);
+    }
+    else
+    {
+        SKuint32  ucap, vcap;
+        SKuint32* un = skBigAllocate(va.size + 1, ucap);
+        SKuint32* vn = skBigAllocate(vb.size, vcap);
+        skBigDivKnuth(qout, rout, va.limbs, va.size, vb.limbs, vb.size, un, vn);
+        skBigRelease(un, ucap);
+        skBigRelease(vn, vcap);
+    }
+
+    const SKuint32 qlen = skBigTrim(qout, va.size - vb.size + 1);
+    const SKuint32 rlen = skBigTrim(rout, vb.size);
+
+    q.adopt(qout, qlen, qcap, qneg && qlen > 0);
+    r.adopt(rout, rlen, rcap, rneg && rlen > 0);
+    return true;
+}
+
+void skBigInteger::gcd(skBigInteger& r, const skBigInteger& a, const skBigInteger& b)
+{
+    skBigInteger x(a), y(b), q, t;
+    if (x.sign() < 0)
+        x.negate();
+    if (y.sign() < 0)
+        y.negate();
+
+    // Euclid on the large values, once both operands fit in a
+    // machine word finish with the binary gcd.
+    while (!y.isZero())
+    {
+        if (x.isSmall() && y.isSmall())
+        {
+            r = skBigInteger(skRational::gcd(x.m_small, y.m_small));
+            return;
+        }
+
+        divMod(q, t, x, y);
+        x = std::move(y);
+        y = std::move(t);
+    }
+    r = std::move(x);
+}
+
+void skBigInteger::print(const char* suffix) const
+{
+    if (isSmall())
+    {
+        printf("%lld%s", (long long)m_small, suffix);
+        return;
+    }
+
+    // Peel off base 10^9 digits from a scratch copy of the magnitude.
+    SKuint32  capacity, dcap;
+    SKuint32* mag    = skBigAllocate(m_size, capacity);
+    SKuint32* digits = skBigAllocate(m_size * 2 + 1, dcap);
+    SKuint32  len    = m_size, count = 0;
+
+    memcpy(mag, m_limbs, m_size * sizeof(SKuint32));
+    while (len > 0)
+    {
+        digits[count++] = skBigDivSmall(mag, mag, len, 1000000000);
+        len             = skBigTrim(mag, len);
+    }
+
+    printf("%s%u", m_negative ? "-" : "", digits[count - 1]);
+    while (count-- > 1)
+        printf("%09u", digits[count - 1]);
+    printf("%s", suffix);
+
+    skBigRelease(mag, capacity);
+    skBigRelease(digits, dcap);
+}
+
+skBigInteger operator+(const skBigInteger& a, const skBigInteger& b)
+{
+    skBigInteger r;
+    skBigInteger::add(r, a, b);
+    return r;
+}
+
+skBigInteger operator-(const skBigInteger& a, const skBigInteger& b)
+{
+    skBigInteger r;
+    skBigInteger::sub(r, a, b);
+    return r;
+}
+
+skBigInteger operator*(const skBigInteger& a, const skBigInteger& b)
+{
+    skBigInteger r;
+    skBigInteger::mul(r, a, b);
+    return r;
+}
+
+skBigInteger operator/(const skBigInteger& a, const skBigInteger& b)
+{
+    skBigInteger q, r;
+    skBigInteger::divMod(q, r, a, b);
+    return q;
+}
+
+skBigInteger operator%(const skBigInteger& a, const skBigInteger& b)
+{
+    skBigInteger q, r;
+    skBigInteger::divMod(q, r, a, b);
+    return r;
+}
@@ -0,0 +1,151 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skBigInteger_h_
+#define _skBigInteger_h_
+
+#include "Math/skMath.h"
+
+/// <summary>
+/// Signed arbitrary precision integer.
+///
+/// Values that fit in 63 bits are stored inline and never touch the heap.
+/// Larger magnitudes are held in 32-bit limbs (least significant first)
+/// that are recycled through a per-thread pool, so temporaries created by
+/// arithmetic do not hit the general purpose allocator.
+/// </summary>
+class skBigInteger
+{
+public:
+    skBigInteger();
+    skBigInteger(SKint64 v);
+    skBigInteger(const skBigInteger& o);
+    skBigInteger(skBigInteger&& o) noexcept;
+    ~skBigInteger();
+
+    skBigInteger& operator=(const skBigInteger& o);
+    skBigInteger& operator=(skBigInteger&& o) noexcept;
+
+    /// <summary>
+    /// True when the value is held inline as a 64-bit integer.
+    /// </summary>
+    SK_INLINE bool isSmall() const
+    {
+        return m_limbs == nullptr;
+    }
+
+    SK_INLINE SKint64 small() const
+    {
+        return m_small;
+    }
+
+    SK_INLINE bool isZero() const
+    {
+        return isSmall() && m_small == 0;
+    }
+
+    int sign() const;
+
+    /// <summary>
+    /// Number of 32-bit limbs needed for the magnitude.
+    /// </summary>
+    SKuint32 size() const;
+
+    /// <summary>
+    /// Returns m such that the value is approximately m * 2^exponent.
+    /// </summary>
+    double toDouble(int& exponent) const;
+
+    double toDouble() const;
+
+    void negate();
+
+    skBigInteger operator-() const;
+
+    static int  compare(const skBigInteger& a, const skBigInteger& b);
+    static void add(skBigInteger& r, const skBigInteger& a, const skBigInteger& b);
+    static void sub(skBigInteger& r, const skBigInteger& a, const skBigInteger& b);
+    static void mul(skBigInteger& r, const skBigInteger& a, const skBigInteger& b);
+
+    /// <summary>
+    /// Truncating division, q = a / b and r = a - q * b.
+    /// Returns false and leaves q and r untouched if b is zero.
+    /// </summary>
+    static bool divMod(skBigInteger& q, skBigInteger& r, const skBigInteger& a, const skBigInteger& b);
+
+    /// <summary>
+    /// Non-negative greatest common divisor of a and b.
+    /// </summary>
+    static void gcd(skBigInteger& r, const skBigInteger& a, const skBigInteger& b);
+
+    void print(const char* suffix = "\n") const;
+
+private:
+    friend class skBigIntegerView;
+
+    void release();
+    void assign(const SKuint32* mag, SKuint32 len, bool negative);
+    void adopt(SKuint32* mag, SKuint32 len, SKuint32 capacity, bool negative);
+
+    SKint64   m_small;
+    SKuint32* m_limbs;
+    SKuint32  m_size;
+    SKuint32  m_capacity;
+    bool      m_negative;
+};
+
+skBigInteger operator+(const skBigInteger& a, const skBigInteger& b);
+skBigInteger operator-(const skBigInteger& a, const skBigInteger& b);
+skBigInteger operator*(const skBigInteger& a, const skBigInteger& b);
+skBigInteger operator/(const skBigInteger& a, const skBigInteger& b);
+skBigInteger operator%(const skBigInteger& a, const skBigInteger& b);
+
+SK_INLINE bool operator==(const skBigInteger& a, const skBigInteger& b)
+{
+    return skBigInteger::compare(a, b) == 0;
+}
+
+SK_INLINE bool operator!=(const skBigInteger& a, const skBigInteger& b)
+{
+    return skBigInteger::compare(a, b) != 0;
+}
+
+SK_INLINE bool operator<(const skBigInteger& a, const skBigInteger& b)
+{
+    return skBigInteger::compare(a, b) < 0;
+}
+
+SK_INLINE bool operator>(const skBigInteger& a, const skBigInteger& b)
+{
+    return skBigInteger::compare(a, b) > 0;
+}
+
+SK_INLINE bool operator<=(const skBigInteger& a, const skBigInteger& b)
+{
+    return skBigInteger::compare(a, b) <= 0;
+}
+
+SK_INLINE bool operator>=(const skBigInteger& a, const skBigInteger& b)
+{
+    return skBigInteger::compare(a, b) >= 0;
+}
+
+#endif  //_skBigInteger_h_
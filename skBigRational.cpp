@@ -0,0 +1,241 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skBigRational.h"
+#include <cstdio>
+#include <utility>
+
+const SKuint32      skBigRational::ReduceLimit = 8;
+const skBigRational skBigRational::Zero        = skBigRational();
+
+skBigRational::skBigRational() :
+    n(0),
+    d(1),
+    m_limit(ReduceLimit)
+{
+}
+
+skBigRational::skBigRational(SKint64 rn, SKint64 rd) :
+    n(rn),
+    d(rd),
+    m_limit(ReduceLimit)
+{
+    if (rd == 0)
+    {
+        n = 0;
+        d = 1;
+    }
+    else
+    {
+        if (rd < 0)
+        {
+            n.negate();
+            d.negate();
+        }
+        reduce();
+    }
+}
+
+skBigRational::skBigRational(const skBigInteger& rn, const skBigInteger& rd) :
+    n(rn),
+    d(rd),
+    m_limit(ReduceLimit)
+{
+    if (rd.isZero())
+    {
+        n = 0;
+        d = 1;
+    }
+    else
+    {
+        if (rd.sign() < 0)
+        {
+            n.negate();
+            d.negate();
+        }
+        reduce();
+    }
+}
+
+skBigRational::skBigRational(const skRational& r) :
+    skBigRational(r.n, r.d)
+{
+}
+
+skBigRational skBigRational::operator-() const
+{
+    skBigRational r(*this);
+    r.n.negate();
+    return r;
+}
+
+double skBigRational::toDouble() const
+{
+    int          en, ed;
+    const double mn = n.toDouble(en);
+    const double md = d.toDouble(ed);
+    return ldexp(mn / md, en - ed);
+}
+
+void skBigRational::reduce()
+{
+    if (n.isZero())
+        d = 1;
+    else
+    {
+        skBigInteger g, r;
+        skBigInteger::gcd(g, n, d);
+
+        if (g != skBigInteger(1))
+        {
+            skBigInteger::divMod(n, r, n, g);
+            skBigInteger::divMod(d, r, d, g);
+        }
+    }
+
+    m_limit = skMax(ReduceLimit, 2 * (n.size() + d.size()));
+}
+
+void skBigRational::reduceLazy()
+{
+    if (n.size() + d.size() > m_limit)
+        reduce();
+}
+
+int skBigRational::compare(const skBigRational& a, const skBigRational& b)
+{
+    // Both denominators are positive so the sign of a - b is the sign of
+    // a.n * b.d - b.n * a.d.
+    if (a.d == b.d)
+        return skBigInteger::compare(a.n, b.n);
+
+    const int sa = a.n.sign(), sb = b.n.sign();
+    if (sa != sb)
+        return sa < sb ? -1 : 1;
+    return skBigInteger::compare(a.n * b.d, b.n * a.d);
+}
+
+void skBigRational::add(skBigRational& r, const skBigRational& a, const skBigRational& b)
+{
+    skBigInteger rn, rd;
+    if (a.d == b.d)
+    {
+        skBigInteger::add(rn, a.n, b.n);
+        rd = a.d;
+    }
+    else
+    {
+        skBigInteger t;
+        skBigInteger::mul(rn, a.n, b.d);
+        skBigInteger::mul(t, b.n, a.d);
+        skBigInteger::add(rn, rn, t);
+        skBigInteger::mul(rd, a.d, b.d);
+    }
+
+    r.m_limit = skMax(a.m_limit, b.m_limit);
+    r.n       = std::move(rn);
+    r.d       = std::move(rd);
+    r.reduceLazy();
+}
+
+void skBigRational::sub(skBigRational& r, const skBigRational& a, const skBigRational& b)
+{
+    add(r, a, -b);
+}
+
+void skBigRational::mul(skBigRational& r, const skBigRational& a, const skBigRational& b)
+{
+    skBigInteger rn, rd;
+    skBigInteger::mul(rn, a.n, b.n);
+    skBigInteger::mul(rd, a.d, b.d);
+
+    r.m_limit = skMax(a.m_limit, b.m_limit);
+    r.n       = std::move(rn);
+    r.d       = std::move(rd);
+    r.reduceLazy();
+}
+
+bool skBigRational::div(skBigRational& r, const skBigRational& a, const skBigRational& b)
+{
+    if (b.n.isZero())
+    {
+        // Math Error: division by zero.
+        r = Zero;
+        return false;
+    }
+
+    skBigInteger rn, rd;
+    skBigInteger::mul(rn, a.n, b.d);
+    skBigInteger::mul(rd, a.d, b.n);
+    if (rd.sign() < 0)
+    {
+        rn.negate();
+        rd.negate();
+    }
+
+    r.m_limit = skMax(a.m_limit, b.m_limit);
+    r.n       = std::move(rn);
+    r.d       = std::move(rd);
+    r.reduceLazy();
+    return true;
+}
+
+void skBigRational::print() const
+{
+    skBigRational t(*this);
+    t.reduce();
+
+    if (t.d == skBigInteger(1))
+        t.n.print();
+    else
+    {
+        t.n.print("/");
+        t.d.print();
+    }
+}
+
+skBigRational operator+(const skBigRational& a, const skBigRational& b)
+{
+    skBigRational r;
+    skBigRational::add(r, a, b);
+    return r;
+}
+
+skBigRational operator-(const skBigRational& a, const skBigRational& b)
+{
+    skBigRational r;
+    skBigRational::sub(r, a, b);
+    return r;
+}
+
+skBigRational operator*(const skBigRational& a, const skBigRational& b)
+{
+    skBigRational r;
+    skBigRational::mul(r, a, b);
+    return r;
+}
+
+skBigRational operator/(const skBigRational& a, const skBigRational& b)
+{
+    skBigRational r;
+    skBigRational::div(r, a, b);
+    return r;
+}
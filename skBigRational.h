@@ -0,0 +1,134 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skBigRational_h_
+#define _skBigRational_h_
+
+#include "Math/skBigInteger.h"
+#include "Math/skRational.h"
+
+/// <summary>
+/// Exact fraction n/d that never overflows.
+///
+/// Small values run on the inline 64-bit path of skBigInteger. Reduction
+/// is deferred while the operands stay small enough that carrying common
+/// factors is cheaper than computing a gcd; once the limb count passes
+/// the reduction limit the value is brought to lowest terms and the limit
+/// is raised relative to the reduced size. The denominator is always
+/// positive, so signs and comparisons never require a reduced value.
+/// </summary>
+class skBigRational
+{
+public:
+    /// <summary>
+    /// Combined limb count of n and d that triggers a reduction.
+    /// </summary>
+    static const SKuint32 ReduceLimit;
+
+    static const skBigRational Zero;
+
+    skBigInteger n, d;
+
+public:
+    skBigRational();
+    skBigRational(SKint64 n, SKint64 d = 1);
+    skBigRational(const skBigInteger& n, const skBigInteger& d);
+    skBigRational(const skRational& r);
+    skBigRational(const skBigRational& o) = default;
+    skBigRational(skBigRational&& o) noexcept = default;
+
+    skBigRational& operator=(const skBigRational& o) = default;
+    skBigRational& operator=(skBigRational&& o) noexcept = default;
+
+    skBigRational operator-() const;
+
+    explicit operator skScalar() const
+    {
+        return (skScalar)toDouble();
+    }
+
+    double toDouble() const;
+
+    SK_INLINE int sign() const
+    {
+        return n.sign();
+    }
+
+    static int compare(const skBigRational& a, const skBigRational& b);
+
+    static void add(skBigRational& r, const skBigRational& a, const skBigRational& b);
+    static void sub(skBigRational& r, const skBigRational& a, const skBigRational& b);
+    static void mul(skBigRational& r, const skBigRational& a, const skBigRational& b);
+
+    /// <summary>
+    /// Returns false and stores zero if b is zero.
+    /// </summary>
+    static bool div(skBigRational& r, const skBigRational& a, const skBigRational& b);
+
+    /// <summary>
+    /// Brings the value to lowest terms.
+    /// </summary>
+    void reduce();
+
+    void print() const;
+
+private:
+    void reduceLazy();
+
+    SKuint32 m_limit;
+};
+
+skBigRational operator-(const skBigRational& a, const skBigRational& b);
+skBigRational operator+(const skBigRational& a, const skBigRational& b);
+skBigRational operator*(const skBigRational& a, const skBigRational& b);
+skBigRational operator/(const skBigRational& a, const skBigRational& b);
+
+SK_INLINE bool operator==(const skBigRational& a, const skBigRational& b)
+{
+    return skBigRational::compare(a, b) == 0;
+}
+
+SK_INLINE bool operator!=(const skBigRational& a, const skBigRational& b)
+{
+    return skBigRational::compare(a, b) != 0;
+}
+
+SK_INLINE bool operator<(const skBigRational& a, const skBigRational& b)
+{
+    return skBigRational::compare(a, b) < 0;
+}
+
+SK_INLINE bool operator>(const skBigRational& a, const skBigRational& b)
+{
+    return skBigRational::compare(a, b) > 0;
+}
+
+SK_INLINE bool operator<=(const skBigRational& a, const skBigRational& b)
+{
+    return skBigRational::compare(a, b) <= 0;
+}
+
+SK_INLINE bool operator>=(const skBigRational& a, const skBigRational& b)
+{
+    return skBigRational::compare(a, b) >= 0;
+}
+
+#endif  //_skBigRational_h_
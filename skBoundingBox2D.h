@@ -81,6 +81,14 @@ public:
         return skAbs((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1)) < SK_EPSILON;
     }
 
+    /// <summary>
+    /// Closed interval test, so touching boxes overlap.
+    /// </summary>
+    SK_INLINE bool overlaps(const skBoundingBox2D& b) const
+    {
+        return x1 <= b.x2 && b.x1 <= x2 && y1 <= b.y2 && b.y1 <= y2;
+    }
+
     void compare(skScalar x, skScalar y);
     void compare(const skRectangle& rct);
 
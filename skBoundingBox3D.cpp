@@ -0,0 +1,215 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skBoundingBox3D.h"
+#include "skSimdKernels.inl"
+
+namespace
+{
+    bool slab(const skBoundingBox3D& box,
+              const skRay&           ray,
+              const skVector2&       limit,
+              skScalar&              t,
+              skVector3*             normal)
+    {
+        const skScalar lo[3] = {box.x1, box.y1, box.z1};
+        const skScalar hi[3] = {box.x2, box.y2, box.z2};
+
+        skScalar tn = -SK_INFINITY, tf = SK_INFINITY;
+        skScalar sn = 0, sf = 0;
+        int      an = 0, af = 0;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            const skScalar ok = ray.origin.ptr()[k];
+            const skScalar dk = ray.direction.ptr()[k];
+
+            if (dk == 0)
+            {
+                if (ok < lo[k] || ok > hi[k])
+                    return false;
+                continue;
+            }
+
+            const skScalar inv = 1 / dk;
+
+            skScalar t1 = (lo[k] - ok) * inv, s1 = -1;
+            skScalar t2 = (hi[k] - ok) * inv, s2 = 1;
+            if (t1 > t2)
+            {
+                skScalar tmp = t1;
+                t1 = t2, t2 = tmp;
+                s1 = 1, s2 = -1;
+            }
+
+            if (t1 > tn)
+                tn = t1, sn = s1, an = k;
+            if (t2 < tf)
+                tf = t2, sf = s2, af = k;
+            if (tn > tf)
+                return false;
+        }
+
+        if (tn >= limit.x && tn <= limit.y)
+        {
+            t = tn;
+            if (normal)
+            {
+                *normal           = skVector3::Zero;
+                normal->ptr()[an] = sn;
+            }
+            return true;
+        }
+        if (tn < limit.x && tf >= limit.x && tf <= limit.y)
+        {
+            t = tf;
+            if (normal)
+            {
+                *normal           = skVector3::Zero;
+                normal->ptr()[af] = sf;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    template <typename F>
+    void broadcast(RayLanes<F>& d, const skTraversalRay& ray)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            d.o[k]   = F(ray.origin.ptr()[k]);
+            d.inv[k] = F(ray.inverse.ptr()[k]);
+        }
+        d.tmin = F(ray.tmin);
+        d.tmax = F(ray.tmax);
+    }
+}  // namespace
+
+const skBoundingBox3D skBoundingBox3D::Identity = skBoundingBox3D(SK_INFINITY, SK_INFINITY, SK_INFINITY, -SK_INFINITY, -SK_INFINITY, -SK_INFINITY);
+
+void skBoundingBox3D::compare(skScalar x, skScalar y, skScalar z)
+{
+    if (x < x1) x1 = x;
+    if (x > x2) x2 = x;
+    if (y < y1) y1 = y;
+    if (y > y2) y2 = y;
+    if (z < z1) z1 = z;
+    if (z > z2) z2 = z;
+}
+
+void skBoundingBox3D::compare(const skVector3& v)
+{
+    compare(v.x, v.y, v.z);
+}
+
+void skBoundingBox3D::compare(const skBoundingBox3D& aabb)
+{
+    if (aabb.x1 < x1) x1 = aabb.x1;
+    if (aabb.x2 > x2) x2 = aabb.x2;
+    if (aabb.y1 < y1) y1 = aabb.y1;
+    if (aabb.y2 > y2) y2 = aabb.y2;
+    if (aabb.z1 < z1) z1 = aabb.z1;
+    if (aabb.z2 > z2) z2 = aabb.z2;
+}
+
+void skBoundingBox3D::compare(const skVector3* points, SKsize count)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    i = skSimdDispatch::kernels().pointBounds(&x1, reinterpret_cast<const float*>(points), count);
+#endif
+    for (; i < count; ++i)
+        compare(points[i]);
+}
+
+void skBoundingBox3D::compare(const skBoundingBox3D* boxes, SKsize count)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    i = skSimdDispatch::kernels().boxBounds(&x1, reinterpret_cast<const float*>(boxes), count);
+#endif
+    for (; i < count; ++i)
+        compare(boxes[i]);
+}
+
+bool skBoundingBox3D::hit(skScalar& t, const skRay& ray, const skVector2& limit) const
+{
+    return slab(*this, ray, limit, t, nullptr);
+}
+
+bool skBoundingBox3D::hit(skRayHitTest& ht, const skRay& ray, const skVector2& limit) const
+{
+    if (slab(*this, ray, limit, ht.distance, &ht.normal))
+    {
+        ht.point = ray.at(ht.distance);
+        return true;
+    }
+    return false;
+}
+
+bool skBoundingBox3D::hit(skScalar& t, const skTraversalRay& ray) const
+{
+    const skScalar b[2][3] = {{x1, y1, z1}, {x2, y2, z2}};
+
+    skScalar front[3], back[3];
+    for (int k = 0; k < 3; ++k)
+    {
+        front[k] = b[ray.sign[k]][k];
+        back[k]  = b[1 - ray.sign[k]][k];
+    }
+
+    RayLanes<skScalar> r;
+    broadcast(r, ray);
+    return entry(t, r, front, back);
+}
+
+SKsize skBoundingBox3D::hit(SKuint32*              hits,
+                            skScalar*              t,
+                            const skTraversalRay&  ray,
+                            const skBoundingBox3D* boxes,
+                            SKsize                 count)
+{
+    SKsize n = 0, i = 0;
+
+#ifndef SK_DOUBLE
+    static_assert(sizeof(skBoundingBox3D) == 6 * sizeof(float), "the box kernel reads six floats per box");
+
+    skSimdDispatch::BoxRay r;
+    for (int k = 0; k < 3; ++k)
+    {
+        r.origin[k]  = ray.origin.ptr()[k];
+        r.inverse[k] = ray.inverse.ptr()[k];
+        r.sign[k]    = ray.sign[k];
+    }
+    r.tmin = ray.tmin;
+    r.tmax = ray.tmax;
+
+    n = skSimdDispatch::kernels().boxHit(hits, t, i, r, &boxes->x1, count);
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (boxes[i].hit(t[n], ray))
+            hits[n++] = (SKuint32)i;
+    }
+    return n;
+}
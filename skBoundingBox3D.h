@@ -0,0 +1,139 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skBoundingBox3D_h_
+#define _skBoundingBox3D_h_
+
+#include "skMath.h"
+#include "skRay.h"
+#include "skVector2.h"
+#include "skVector3.h"
+
+class skBoundingBox3D
+{
+public:
+    static const skBoundingBox3D Identity;
+
+public:
+    skBoundingBox3D()
+    {
+        clear();
+    }
+
+    skBoundingBox3D(skScalar _x1, skScalar _y1, skScalar _z1, skScalar _x2, skScalar _y2, skScalar _z2) :
+        x1(_x1),
+        y1(_y1),
+        z1(_z1),
+        x2(_x2),
+        y2(_y2),
+        z2(_z2)
+    {
+    }
+
+    skBoundingBox3D(const skVector3& lo, const skVector3& hi) :
+        x1(lo.x),
+        y1(lo.y),
+        z1(lo.z),
+        x2(hi.x),
+        y2(hi.y),
+        z2(hi.z)
+    {
+    }
+
+    skBoundingBox3D(const skBoundingBox3D& aabb) = default;
+
+    SK_INLINE void clear()
+    {
+        *this = Identity;
+    }
+
+    SK_INLINE skVector3 center() const
+    {
+        return skVector3((x1 + x2) * skScalar(0.5), (y1 + y2) * skScalar(0.5), (z1 + z2) * skScalar(0.5));
+    }
+
+    SK_INLINE skVector3 extent() const
+    {
+        return skVector3((x2 - x1) * skScalar(0.5), (y2 - y1) * skScalar(0.5), (z2 - z1) * skScalar(0.5));
+    }
+
+    SK_INLINE bool contains(const skVector3& p) const
+    {
+        return p.x >= x1 && p.x <= x2 && p.y >= y1 && p.y <= y2 && p.z >= z1 && p.z <= z2;
+    }
+
+    /// <summary>
+    /// Closed interval test, so touching boxes overlap.
+    /// </summary>
+    SK_INLINE bool overlaps(const skBoundingBox3D& b) const
+    {
+        return x1 <= b.x2 && b.x1 <= x2 && y1 <= b.y2 && b.y1 <= y2 && z1 <= b.z2 && b.z1 <= z2;
+    }
+
+    /// <summary>
+    /// Slab test. Reports the first crossing of the surface with
+    /// limit.x <= t <= limit.y, so a ray that starts inside hits the
+    /// exit face.
+    /// </summary>
+    bool hit(skScalar& t, const skRay& ray, const skVector2& limit) const;
+
+    bool hit(skRayHitTest& ht, const skRay& ray, const skVector2& limit) const;
+
+    /// <summary>
+    /// Slab test for traversal, on the precomputed reciprocal. Reports
+    /// the entry distance clamped to [ray.tmin, ray.tmax], so a ray that
+    /// starts inside reports ray.tmin.
+    /// </summary>
+    bool hit(skScalar& t, const skTraversalRay& ray) const;
+
+    /// <summary>
+    /// Tests ray against count boxes and writes the indices of the hit
+    /// ones to hits, and their entry distances to t, in order. Returns
+    /// the number written. Single precision tests the boxes at the width
+    /// skSimdDispatch picks.
+    /// </summary>
+    static SKsize hit(SKuint32*              hits,
+                      skScalar*              t,
+                      const skTraversalRay&  ray,
+                      const skBoundingBox3D* boxes,
+                      SKsize                 count);
+
+    void compare(skScalar x, skScalar y, skScalar z);
+    void compare(const skVector3& v);
+    void compare(const skBoundingBox3D& aabb);
+
+    /// <summary>
+    /// Grows the box to enclose count points. Single precision reduces
+    /// at the width skSimdDispatch picks.
+    /// </summary>
+    void compare(const skVector3* points, SKsize count);
+
+    /// <summary>
+    /// Grows the box to enclose count boxes.
+    /// </summary>
+    void compare(const skBoundingBox3D* boxes, SKsize count);
+
+    skBoundingBox3D& operator=(const skBoundingBox3D& v) = default;
+
+    skScalar x1{}, y1{}, z1{}, x2{}, y2{}, z2{};
+};
+
+#endif  //_skBoundingBox3D_h_
@@ -34,19 +34,12 @@
 #define SK_A 0
 #endif
 
-const skColor skColor::White = skColor(1, 1, 1, 1);
-const skColor skColor::Black = skColor(0, 0, 0, 1);
-
-const skScalar skColorUtils::i100 = skScalar(1.0 / 100.0);
-const skScalar skColorUtils::i255 = skScalar(1.0 / 255.0);
-const skScalar skColorUtils::i360 = skScalar(1.0 / 360.0);
-
-// constants for rotating
-const skScalar i1 = skPiO3;
-const skScalar i2 = 2 * skPiO3;
-const skScalar i3 = 3 * skPiO3;
-const skScalar i4 = 4 * skPiO3;
-const skScalar i5 = 5 * skPiO3;
+// Sector boundaries of the hue, in units of 60 degrees.
+constexpr skScalar i1 = 1;
+constexpr skScalar i2 = 2;
+constexpr skScalar i3 = 3;
+constexpr skScalar i4 = 4;
+constexpr skScalar i5 = 5;
 
 skColor::skColor(const skVector3& v) :
     r(v.x),
@@ -233,6 +226,8 @@ void skColorUtils::convert(skColorHSV& dst, const skColor& src)
         dst.h = skPiO3 * (skScalar(4) + (src.r - src.g) / dst.a);
 
     dst.h *= skDPR;
+    if (dst.h < skScalar(0.0))
+        dst.h += skScalar(360.0);
     dst.h = skCeil(dst.h);
     dst.s = dst.v;
     if (dst.v > 0)
@@ -23,7 +23,6 @@
 #define _skColor_h_
 
 #include "skMath.h"
-class skVector3;
 
 typedef unsigned int skColori;
 
@@ -45,9 +44,9 @@ typedef union skColorUF
 class skColorUtils
 {
 public:
-    static const skScalar i100;
-    static const skScalar i255;
-    static const skScalar i360;
+    static constexpr skScalar i100 = skScalar(1.0 / 100.0);
+    static constexpr skScalar i255 = skScalar(1.0 / 255.0);
+    static constexpr skScalar i360 = skScalar(1.0 / 360.0);
 
     static void convert(skColori& dst, const skColor& src);
     static void convert(skColor& dst, const skColori& src);
@@ -140,7 +139,7 @@ public:
     {
     }
 
-    skColor(skScalar _r, skScalar _g, skScalar _b, skScalar _a = skScalar(1.0)) :
+    constexpr skColor(skScalar _r, skScalar _g, skScalar _b, skScalar _a = skScalar(1.0)) :
         r(_r),
         g(_g),
         b(_b),
@@ -280,24 +279,24 @@ public:
             skClamp<skScalar>(a, 0, 1));
     }
 
-    skColor operator+(skScalar v) const
+    constexpr skColor operator+(skScalar v) const
     {
         return skColor(r + v, g + v, b + v, a);
     }
 
-    skColor operator+(const skColor& v) const
+    constexpr skColor operator+(const skColor& v) const
     {
         return skColor(r + v.r, g + v.g, b + v.b, a);
     }
 
-    skColor& operator+=(skScalar v)
+    constexpr skColor& operator+=(skScalar v)
     {
         r += v;
         g += v;
         b += v;
         return *this;
     }
-    skColor& operator+=(const skColor& v)
+    constexpr skColor& operator+=(const skColor& v)
     {
         r += v.r;
         g += v.g;
@@ -305,22 +304,22 @@ public:
         return *this;
     }
 
-    friend skColor operator+(const skScalar rc, const skColor& l)
+    friend constexpr skColor operator+(const skScalar rc, const skColor& l)
     {
         return l + rc;
     }
 
-    skColor operator-(skScalar v) const
+    constexpr skColor operator-(skScalar v) const
     {
         return skColor(r - v, g - v, b - v, a);
     }
 
-    skColor operator-(const skColor& v) const
+    constexpr skColor operator-(const skColor& v) const
     {
         return skColor(r - v.r, g - v.g, b - v.b, a);
     }
 
-    skColor& operator-=(skScalar v)
+    constexpr skColor& operator-=(skScalar v)
     {
         r -= v;
         g -= v;
@@ -328,7 +327,7 @@ public:
         return *this;
     }
 
-    skColor& operator-=(const skColor& v)
+    constexpr skColor& operator-=(const skColor& v)
     {
         r -= v.r;
         g -= v.g;
@@ -336,22 +335,22 @@ public:
         return *this;
     }
 
-    friend skColor operator-(const skScalar rc, const skColor& l)
+    friend constexpr skColor operator-(const skScalar rc, const skColor& l)
     {
         return l - rc;
     }
 
-    skColor operator*(skScalar v) const
+    constexpr skColor operator*(skScalar v) const
     {
         return skColor(r * v, g * v, b * v, a);
     }
 
-    skColor operator*(const skColor& v) const
+    constexpr skColor operator*(const skColor& v) const
     {
         return skColor(r * v.r, g * v.g, b * v.b, a);
     }
 
-    skColor& operator*=(skScalar v)
+    constexpr skColor& operator*=(skScalar v)
     {
         r *= v;
         g *= v;
@@ -359,7 +358,7 @@ public:
         return *this;
     }
 
-    skColor& operator*=(const skColor& v)
+    constexpr skColor& operator*=(const skColor& v)
     {
         r *= v.r;
         g *= v.g;
@@ -367,24 +366,24 @@ public:
         return *this;
     }
 
-    friend skColor operator*(skScalar rc, const skColor& l)
+    friend constexpr skColor operator*(skScalar rc, const skColor& l)
     {
         return l * rc;
     }
 
-    skColor operator/(skScalar v) const
+    constexpr skColor operator/(skScalar v) const
     {
         if (skIsZero(v))
             v = 1;
         return skColor(r / v, g / v, b / v, a);
     }
 
-    skColor operator/(const skColor& v) const
+    constexpr skColor operator/(const skColor& v) const
     {
         return skColor(r / v.r, g / v.g, b / v.b, a);
     }
 
-    skColor& operator/=(skScalar v)
+    constexpr skColor& operator/=(skScalar v)
     {
         r /= v;
         g /= v;
@@ -392,7 +391,7 @@ public:
         return *this;
     }
 
-    skColor& operator/=(const skColor& v)
+    constexpr skColor& operator/=(const skColor& v)
     {
         r /= v.r;
         g /= v.g;
@@ -400,12 +399,12 @@ public:
         return *this;
     }
 
-    friend skColor operator/(skScalar rc, const skColor& l)
+    friend constexpr skColor operator/(skScalar rc, const skColor& l)
     {
         return l / rc;
     }
 
-    skColor& operator=(const skColor& o) = default;
+    constexpr skColor& operator=(const skColor& o) = default;
 
     skScalar* ptr()
     {
@@ -435,6 +434,9 @@ public:
     }
 };
 
+inline constexpr skColor skColor::White = skColor(1, 1, 1, 1);
+inline constexpr skColor skColor::Black = skColor(0, 0, 0, 1);
+
 SK_INLINE void skLimitRGB(skColor& dest)
 {
     // f(x) x {0 <= x <= 1}
@@ -0,0 +1,219 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skConvexShape_h_
+#define _skConvexShape_h_
+
+#include "skOrientedBox3D.h"
+#include "skVector3.h"
+
+/// <summary>
+/// Sphere, for use with skGjk.
+/// </summary>
+class skConvexSphere
+{
+public:
+    skVector3 center;
+    skScalar  radius;
+
+public:
+    skConvexSphere() = default;
+
+    skConvexSphere(const skVector3& c, skScalar r) :
+        center(c),
+        radius(r)
+    {
+    }
+
+    SK_INLINE skVector3 support(const skVector3& dir) const
+    {
+        return center + dir.normalized() * radius;
+    }
+};
+
+/// <summary>
+/// The points within radius of the segment [a, b], for use with skGjk.
+/// </summary>
+class skConvexCapsule
+{
+public:
+    skVector3 a, b;
+    skScalar  radius;
+
+public:
+    skConvexCapsule() = default;
+
+    skConvexCapsule(const skVector3& p0, const skVector3& p1, skScalar r) :
+        a(p0),
+        b(p1),
+        radius(r)
+    {
+    }
+
+    SK_INLINE skVector3 segmentSupport(const skVector3& dir) const
+    {
+        return a.dot(dir) >= b.dot(dir) ? a : b;
+    }
+
+    SK_INLINE skVector3 support(const skVector3& dir) const
+    {
+        return segmentSupport(dir) + dir.normalized() * radius;
+    }
+};
+
+/// <summary>
+/// Convex hull of a point array, for use with skGjk. The points are not
+/// copied and the support mapping scans all of them.
+/// </summary>
+class skConvexHull
+{
+public:
+    const skVector3* points;
+    SKuint32         count;
+
+public:
+    skConvexHull() :
+        points(nullptr),
+        count(0)
+    {
+    }
+
+    skConvexHull(const skVector3* p, SKuint32 n) :
+        points(p),
+        count(n)
+    {
+    }
+
+    SK_INLINE skVector3 support(const skVector3& dir) const
+    {
+        SKuint32 best = 0;
+        skScalar dot  = points[0].dot(dir);
+        for (SKuint32 i = 1; i < count; ++i)
+        {
+            const skScalar d = points[i].dot(dir);
+            if (d > dot)
+                dot = d, best = i;
+        }
+        return points[best];
+    }
+};
+
+/// <summary>
+/// Type erased reference to a convex shape, split into a core support
+/// mapping and a margin: the shape is every point within margin() of
+/// the core. Spheres and capsules have point and segment cores, so skGjk
+/// can treat their rounded surfaces exactly. The referenced shape must
+/// outlive this object.
+/// </summary>
+class skConvexShape
+{
+public:
+    typedef skVector3 (*SupportFn)(const void* shape, const skVector3& dir);
+
+public:
+    skConvexShape(const skConvexSphere& s) :
+        m_shape(&s),
+        m_support(&sphereCore),
+        m_margin(s.radius)
+    {
+    }
+
+    skConvexShape(const skConvexCapsule& c) :
+        m_shape(&c),
+        m_support(&capsuleCore),
+        m_margin(c.radius)
+    {
+    }
+
+    skConvexShape(const skConvexHull& h) :
+        m_shape(&h),
+        m_support(&call<skConvexHull>),
+        m_margin(0)
+    {
+    }
+
+    skConvexShape(const skOrientedBox3D& b) :
+        m_shape(&b),
+        m_support(&call<skOrientedBox3D>),
+        m_margin(0)
+    {
+    }
+
+    /// <summary>
+    /// Wraps any type with a skVector3 support(const skVector3&) const
+    /// member, optionally rounded by margin.
+    /// </summary>
+    template <typename T>
+    static skConvexShape wrap(const T& shape, skScalar margin = 0)
+    {
+        return skConvexShape(&shape, &call<T>, margin);
+    }
+
+    SK_INLINE skVector3 coreSupport(const skVector3& dir) const
+    {
+        return m_support(m_shape, dir);
+    }
+
+    /// <summary>
+    /// The support point of the full shape, core plus margin.
+    /// </summary>
+    SK_INLINE skVector3 support(const skVector3& dir) const
+    {
+        if (m_margin > 0)
+            return m_support(m_shape, dir) + dir.normalized() * m_margin;
+        return m_support(m_shape, dir);
+    }
+
+    SK_INLINE skScalar margin() const
+    {
+        return m_margin;
+    }
+
+private:
+    skConvexShape(const void* shape, SupportFn fn, skScalar margin) :
+        m_shape(shape),
+        m_support(fn),
+        m_margin(margin)
+    {
+    }
+
+    template <typename T>
+    static skVector3 call(const void* shape, const skVector3& dir)
+    {
+        return static_cast<const T*>(shape)->support(dir);
+    }
+
+    static skVector3 sphereCore(const void* shape, const skVector3&)
+    {
+        return static_cast<const skConvexSphere*>(shape)->center;
+    }
+
+    static skVector3 capsuleCore(const void* shape, const skVector3& dir)
+    {
+        return static_cast<const skConvexCapsule*>(shape)->segmentSupport(dir);
+    }
+
+    const void* m_shape;
+    SupportFn   m_support;
+    skScalar    m_margin;
+};
+
+#endif  //_skConvexShape_h_
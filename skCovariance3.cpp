@@ -0,0 +1,173 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skCovariance3.h"
+#include "skFrameArena.h"
+#include "skParallel.h"
+
+namespace
+{
+    // Points reduced about a common mean before merging.
+    const SKsize BlockSize = 256;
+
+    // Points per worker before threads pay off.
+    const SKsize Grain = 16384;
+}  // namespace
+
+void skCovariance3::clear()
+{
+    m_count = 0;
+    m_mean  = skVector3::Zero;
+    m_xx = m_xy = m_xz = 0;
+    m_yy = m_yz = m_zz = 0;
+}
+
+void skCovariance3::add(const skVector3& point)
+{
+    ++m_count;
+
+    const skVector3 d0 = point - m_mean;
+    m_mean += d0 / skScalar(m_count);
+    const skVector3 d1 = point - m_mean;
+
+    m_xx += d0.x * d1.x;
+    m_xy += d0.x * d1.y;
+    m_xz += d0.x * d1.z;
+    m_yy += d0.y * d1.y;
+    m_yz += d0.y * d1.z;
+    m_zz += d0.z * d1.z;
+}
+
+void skCovariance3::add(const skVector3* points, SKsize count)
+{
+    while (count > 0)
+    {
+        const SKsize n = count < BlockSize ? count : BlockSize;
+
+        skScalar sx = 0, sy = 0, sz = 0;
+        for (SKsize i = 0; i < n; ++i)
+        {
+            sx += points[i].x;
+            sy += points[i].y;
+            sz += points[i].z;
+        }
+
+        skCovariance3 block;
+        block.m_count = n;
+        block.m_mean  = skVector3(sx, sy, sz) / skScalar(n);
+
+        const skScalar mx = block.m_mean.x;
+        const skScalar my = block.m_mean.y;
+        const skScalar mz = block.m_mean.z;
+
+        skScalar xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+        for (SKsize i = 0; i < n; ++i)
+        {
+            const skScalar dx = points[i].x - mx;
+            const skScalar dy = points[i].y - my;
+            const skScalar dz = points[i].z - mz;
+
+            xx += dx * dx;
+            xy += dx * dy;
+            xz += dx * dz;
+            yy += dy * dy;
+            yz += dy * dz;
+            zz += dz * dz;
+        }
+
+        block.m_xx = xx;
+        block.m_xy = xy;
+        block.m_xz = xz;
+        block.m_yy = yy;
+        block.m_yz = yz;
+        block.m_zz = zz;
+
+        merge(block);
+
+        points += n;
+        count -= n;
+    }
+}
+
+void skCovariance3::merge(const skCovariance3& other)
+{
+    if (other.m_count == 0)
+        return;
+    if (m_count == 0)
+    {
+        *this = other;
+        return;
+    }
+
+    const SKsize   n  = m_count + other.m_count;
+    const skScalar fa = skScalar(m_count) / skScalar(n);
+    const skScalar fb = skScalar(other.m_count) / skScalar(n);
+    const skScalar w  = skScalar(m_count) * fb;
+
+    const skVector3 d = other.m_mean - m_mean;
+
+    m_xx += other.m_xx + d.x * d.x * w;
+    m_xy += other.m_xy + d.x * d.y * w;
+    m_xz += other.m_xz + d.x * d.z * w;
+    m_yy += other.m_yy + d.y * d.y * w;
+    m_yz += other.m_yz + d.y * d.z * w;
+    m_zz += other.m_zz + d.z * d.z * w;
+
+    m_mean  = m_mean * fa + other.m_mean * fb;
+    m_count = n;
+}
+
+skMatrix3 skCovariance3::covariance() const
+{
+    if (m_count == 0)
+        return skMatrix3::Zero;
+
+    const skScalar r = skScalar(1) / skScalar(m_count);
+    return skMatrix3(m_xx * r, m_xy * r, m_xz * r,
+                     m_xy * r, m_yy * r, m_yz * r,
+                     m_xz * r, m_yz * r, m_zz * r);
+}
+
+void skCovariance3::principalAxes(skMatrix3& axes, skVector3& variances) const
+{
+    covariance().eigenSymmetric(axes, variances);
+}
+
+skCovariance3 skCovariance3::compute(const skVector3* points, SKsize count, SKuint32 threads)
+{
+    skFrameArena&             arena = skFrameArena::local();
+    const skFrameArena::Scope scope(arena);
+
+    const skSpan<skCovariance3> parts = arena.allocate<skCovariance3>(skParallel::chunkCount(count, Grain, threads));
+
+    skParallel::forChunks(
+        count,
+        Grain,
+        [&](SKsize chunk, SKsize first, SKsize last) {
+            parts[chunk].add(points + first, last - first);
+        },
+        threads);
+
+    skCovariance3 result;
+    for (const skCovariance3& part : parts)
+        result.merge(part);
+    return result;
+}
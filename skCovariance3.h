@@ -0,0 +1,90 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skCovariance3_h_
+#define _skCovariance3_h_
+
+#include "skMatrix3.h"
+#include "skVector3.h"
+
+/// <summary>
+/// Accumulates the mean and covariance of a point cloud. Points are added
+/// in blocks, each block is reduced about its own mean and merged with the
+/// pairwise update of Chan, Golub and LeVeque, which keeps the sums well
+/// conditioned for clouds far from the origin.
+/// </summary>
+class skCovariance3
+{
+public:
+    skCovariance3()
+    {
+        clear();
+    }
+
+    void clear();
+
+    void add(const skVector3& point);
+
+    void add(const skVector3* points, SKsize count);
+
+    /// <summary>
+    /// Adds the points of another accumulator.
+    /// </summary>
+    void merge(const skCovariance3& other);
+
+    SKsize count() const
+    {
+        return m_count;
+    }
+
+    const skVector3& mean() const
+    {
+        return m_mean;
+    }
+
+    /// <summary>
+    /// Returns the population covariance, or zero when empty.
+    /// </summary>
+    skMatrix3 covariance() const;
+
+    /// <summary>
+    /// Returns the principal axes in the columns of axes and the variance
+    /// along each in variances, sorted in decreasing order.
+    /// </summary>
+    void principalAxes(skMatrix3& axes, skVector3& variances) const;
+
+    /// <summary>
+    /// Accumulates count points, split over up to threads workers (zero
+    /// uses every hardware thread). The partial results merge in a fixed
+    /// order, so the result does not depend on scheduling.
+    /// </summary>
+    static skCovariance3 compute(const skVector3* points, SKsize count, SKuint32 threads = 0);
+
+private:
+    SKsize    m_count;
+    skVector3 m_mean;
+
+    // Sums of the products of the deviations from the mean.
+    skScalar m_xx, m_xy, m_xz;
+    skScalar m_yy, m_yz, m_zz;
+};
+
+#endif  //_skCovariance3_h_
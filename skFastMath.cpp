@@ -0,0 +1,125 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skFastMath.h"
+#include "skSimdKernels.inl"
+
+// The kernels are instantiated with float/SKint32 for the scalar form
+// and skSimd4f/skSimd4i for the lane form.
+
+float skFastMath::sin(float x)
+{
+    if (fabsf(x) > SinCosLimit)
+        return sinf(x);
+
+    float s, c;
+    sinCosKernel<float, SKint32>(x, s, c);
+    return s;
+}
+
+float skFastMath::cos(float x)
+{
+    if (fabsf(x) > SinCosLimit)
+        return cosf(x);
+
+    float s, c;
+    sinCosKernel<float, SKint32>(x, s, c);
+    return c;
+}
+
+void skFastMath::sinCos(float x, float& s, float& c)
+{
+    if (fabsf(x) > SinCosLimit)
+    {
+        s = sinf(x);
+        c = cosf(x);
+    }
+    else
+        sinCosKernel<float, SKint32>(x, s, c);
+}
+
+float skFastMath::atan2(float y, float x)
+{
+    return atan2Kernel<float, SKint32>(y, x);
+}
+
+float skFastMath::exp(float x)
+{
+    return expKernel<float, SKint32>(x);
+}
+
+float skFastMath::log(float x)
+{
+    return logKernel<float, SKint32>(x);
+}
+
+void skFastMath::sinCos(const skSimd4f& x, skSimd4f& s, skSimd4f& c)
+{
+    sinCosKernel<skSimd4f, skSimd4i>(x, s, c);
+
+    if (skSimdAny(skSimdAbs(x) > skSimd4f(SinCosLimit)))
+    {
+        float xv[4], sv[4], cv[4];
+        x.store(xv);
+        s.store(sv);
+        c.store(cv);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            if (fabsf(xv[i]) > SinCosLimit)
+            {
+                sv[i] = sinf(xv[i]);
+                cv[i] = cosf(xv[i]);
+            }
+        }
+        s = skSimd4f::load(sv);
+        c = skSimd4f::load(cv);
+    }
+}
+
+skSimd4f skFastMath::sin(const skSimd4f& x)
+{
+    skSimd4f s, c;
+    sinCos(x, s, c);
+    return s;
+}
+
+skSimd4f skFastMath::cos(const skSimd4f& x)
+{
+    skSimd4f s, c;
+    sinCos(x, s, c);
+    return c;
+}
+
+skSimd4f skFastMath::atan2(const skSimd4f& y, const skSimd4f& x)
+{
+    return atan2Kernel<skSimd4f, skSimd4i>(y, x);
+}
+
+skSimd4f skFastMath::exp(const skSimd4f& x)
+{
+    return expKernel<skSimd4f, skSimd4i>(x);
+}
+
+skSimd4f skFastMath::log(const skSimd4f& x)
+{
+    return logKernel<skSimd4f, skSimd4i>(x);
+}
@@ -0,0 +1,93 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skFastMath_h_
+#define _skFastMath_h_
+
+#include "skSimd.h"
+
+/// <summary>
+/// Polynomial approximations of the single precision transcendental
+/// functions, in scalar and four lane form. Both forms share the same
+/// kernels and return identical results.
+///
+/// Maximum error against the correctly rounded result, measured over the
+/// listed domain:
+///
+/// sin, cos, sinCos  |x| up to 8192, 2 ulp. Larger |x| falls back to libm.
+/// atan2             finite x and y, 3 ulp.
+/// exp               [-87.3, 88.7], 1 ulp. Above is inf, below the result
+///                   is denormal and reaches 0 at -103.97.
+/// log               positive x including denormals, 1 ulp. log(0) is
+///                   -inf, negative x gives NaN.
+/// rsqrt             positive normal x, 4 ulp.
+///
+/// When SK_FAST_MATH is defined, skSin, skCos, skATan2, skExp, skLog and
+/// skRSqrt map onto these functions for single precision scalars.
+/// </summary>
+class skFastMath
+{
+public:
+    static float sin(float x);
+    static float cos(float x);
+    static void  sinCos(float x, float& s, float& c);
+    static float atan2(float y, float x);
+    static float exp(float x);
+    static float log(float x);
+
+    static skSimd4f sin(const skSimd4f& x);
+    static skSimd4f cos(const skSimd4f& x);
+    static void     sinCos(const skSimd4f& x, skSimd4f& s, skSimd4f& c);
+    static skSimd4f atan2(const skSimd4f& y, const skSimd4f& x);
+    static skSimd4f exp(const skSimd4f& x);
+    static skSimd4f log(const skSimd4f& x);
+
+    /// <summary>
+    /// Hardware estimate refined with one Newton-Raphson step.
+    /// </summary>
+    SK_INLINE static float rsqrt(float x)
+    {
+#ifdef SK_SIMD_SSE2
+        const float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#else
+        const float y = 1.f / sqrtf(x);
+#endif
+        // x * y first, since 0.5 * x is denormal just above FLT_MIN.
+        return y * (1.5f - 0.5f * (x * y) * y);
+    }
+
+    SK_INLINE static skSimd4f rsqrt(const skSimd4f& x)
+    {
+        const skSimd4f y = skSimdRSqrtEst(x);
+        return y * (skSimd4f(1.5f) - skSimd4f(0.5f) * (x * y) * y);
+    }
+
+    /// <summary>
+    /// Double precision has no estimate instruction worth refining,
+    /// so this is the exact form.
+    /// </summary>
+    SK_INLINE static double rsqrt(double x)
+    {
+        return 1.0 / sqrt(x);
+    }
+};
+
+#endif  //_skFastMath_h_
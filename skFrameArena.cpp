@@ -0,0 +1,109 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skFrameArena.h"
+#include <cstdint>
+
+skFrameArena::skFrameArena() :
+    m_block(0),
+    m_offset(0),
+    m_used(0),
+    m_peak(0)
+{
+}
+
+skFrameArena::~skFrameArena()
+{
+    for (const Block& b : m_blocks)
+        skAlignedFree(b.data, skCacheLine);
+}
+
+skFrameArena& skFrameArena::local()
+{
+    static thread_local skFrameArena arena;
+    return arena;
+}
+
+void* skFrameArena::allocate(SKsize size, SKsize align)
+{
+    for (;;)
+    {
+        if (m_block < m_blocks.size())
+        {
+            const Block&    b     = m_blocks[m_block];
+            const uintptr_t base  = (uintptr_t)b.data;
+            const SKsize    start = (SKsize)(((base + m_offset + align - 1) & ~(uintptr_t)(align - 1)) - base);
+
+            if (start <= b.size && size <= b.size - start)
+            {
+                m_used += start - m_offset + size;
+                m_offset = start + size;
+                if (m_used > m_peak)
+                    m_peak = m_used;
+                return b.data + start;
+            }
+
+            // The rest of this block is skipped until the next reset.
+            m_used += b.size - m_offset;
+            m_offset = 0;
+            ++m_block;
+        }
+        else
+            addBlock(size + align > BlockSize ? size + align : BlockSize);
+    }
+}
+
+void skFrameArena::rewind(const Marker& marker)
+{
+    m_block  = marker.block;
+    m_offset = marker.offset;
+    m_used   = marker.used;
+}
+
+void skFrameArena::reset()
+{
+    // A frame that needed several blocks gets them as one from now on.
+    if (m_blocks.size() > 1)
+    {
+        const SKsize size = capacity();
+        for (const Block& b : m_blocks)
+            skAlignedFree(b.data, skCacheLine);
+        m_blocks.clear();
+        addBlock(size);
+    }
+
+    m_block  = 0;
+    m_offset = 0;
+    m_used   = 0;
+}
+
+SKsize skFrameArena::capacity() const
+{
+    SKsize size = 0;
+    for (const Block& b : m_blocks)
+        size += b.size;
+    return size;
+}
+
+void skFrameArena::addBlock(SKsize size)
+{
+    m_blocks.push_back({static_cast<char*>(skAlignedAlloc(size, skCacheLine)), size});
+}
@@ -0,0 +1,180 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skFrameArena_h_
+#define _skFrameArena_h_
+
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "skAligned.h"
+#include "skSpan.h"
+
+/// <summary>
+/// Bump pointer allocator for the scratch arrays of one frame, such as
+/// transformed vertices, culling masks and sort keys, that are handed
+/// to the batch functions and dropped when the frame ends.
+///
+/// allocate() moves a pointer through a block and only asks the system
+/// for memory when the blocks are exhausted. reset() at the end of the
+/// frame releases everything at once; when the frame spilled into more
+/// than one block they are merged into one, so after a few frames a
+/// frame allocates nothing at all.
+///
+/// local() is the arena of the calling thread. Library functions that
+/// take scratch from it do so inside a Scope, which gives the memory
+/// back on return and leaves the caller's allocations alone.
+/// </summary>
+class skFrameArena
+{
+public:
+    /// <summary>
+    /// The size of the first block, and the least size of the others.
+    /// </summary>
+    static constexpr SKsize BlockSize = 64 * 1024;
+
+    /// <summary>
+    /// A position in the arena, taken by mark() and restored by rewind().
+    /// </summary>
+    struct Marker
+    {
+        SKsize block;
+        SKsize offset;
+        SKsize used;
+    };
+
+    /// <summary>
+    /// Rewinds the arena to where it was on construction.
+    /// </summary>
+    class Scope
+    {
+    private:
+        skFrameArena& m_arena;
+        const Marker  m_marker;
+
+    public:
+        explicit Scope(skFrameArena& arena) :
+            m_arena(arena),
+            m_marker(arena.mark())
+        {
+        }
+
+        ~Scope()
+        {
+            m_arena.rewind(m_marker);
+        }
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    struct Block
+    {
+        char*  data;
+        SKsize size;
+    };
+
+    std::vector<Block> m_blocks;
+    SKsize             m_block;
+    SKsize             m_offset;
+    SKsize             m_used;
+    SKsize             m_peak;
+
+public:
+    skFrameArena();
+    ~skFrameArena();
+
+    skFrameArena(const skFrameArena&)            = delete;
+    skFrameArena& operator=(const skFrameArena&) = delete;
+
+    /// <summary>
+    /// The arena of the calling thread.
+    /// </summary>
+    static skFrameArena& local();
+
+    /// <summary>
+    /// Returns size bytes at a multiple of align, a power of two. The
+    /// memory stays valid until reset() or a rewind() past it.
+    /// </summary>
+    void* allocate(SKsize size, SKsize align = skCacheLine);
+
+    /// <summary>
+    /// Returns count default initialized elements starting on a cache
+    /// line. T must be trivially destructible, since nothing is
+    /// destroyed.
+    /// </summary>
+    template <typename T>
+    skSpan<T> allocate(SKsize count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "the arena does not run destructors");
+
+        constexpr SKsize align = alignof(T) > skCacheLine ? alignof(T) : skCacheLine;
+
+        T* p = static_cast<T*>(allocate(count * sizeof(T), align));
+        for (SKsize i = 0; i < count; ++i)
+            new (p + i) T;
+        return skSpan<T>(p, count);
+    }
+
+    Marker mark() const
+    {
+        return {m_block, m_offset, m_used};
+    }
+
+    /// <summary>
+    /// Releases everything allocated after marker was taken.
+    /// </summary>
+    void rewind(const Marker& marker);
+
+    /// <summary>
+    /// Releases everything. Call it once per frame, when none of the
+    /// frame's arrays are in use.
+    /// </summary>
+    void reset();
+
+    /// <summary>
+    /// The bytes handed out since the last reset, including alignment
+    /// and the ends of the blocks that were left for the next one.
+    /// </summary>
+    SKsize used() const
+    {
+        return m_used;
+    }
+
+    /// <summary>
+    /// The most bytes in use at once since construction.
+    /// </summary>
+    SKsize peak() const
+    {
+        return m_peak;
+    }
+
+    /// <summary>
+    /// The bytes held in blocks.
+    /// </summary>
+    SKsize capacity() const;
+
+private:
+    void addBlock(SKsize size);
+};
+
+#endif  //_skFrameArena_h_
@@ -0,0 +1,756 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skGjk.h"
+#include "skParallel.h"
+
+namespace
+{
+    const SKuint32 MaxIterations    = 64;
+    const SKuint32 MaxEpaIterations = 64;
+    const SKuint32 MaxEpaVertices   = MaxEpaIterations + 4;
+    const SKuint32 MaxEpaFaces      = 256;
+    const SKuint32 MaxEpaEdges      = 3 * MaxEpaFaces;
+
+    // Pairs per worker before threads pay off.
+    const SKsize Grain = 64;
+
+    // Convergence tolerance, relative to the distance or to the size of
+    // the shapes.
+    const skScalar Relative = skScalar(100) * SK_EPSILON;
+
+    // A point of the Minkowski difference, w = a - b, with the support
+    // points it came from.
+    // w = a - b, the support point of the difference in direction d.
+    struct Vertex
+    {
+        skVector3 w, a, b, d;
+    };
+
+    struct Simplex
+    {
+        Vertex   v[4];
+        skScalar l[4];
+        SKuint32 n;
+    };
+
+    struct Face
+    {
+        SKuint32  i, j, k;
+        skVector3 n;
+        skScalar  d;
+        bool      alive;
+    };
+
+    struct Edge
+    {
+        SKuint32 a, b;
+    };
+
+    // Support mapping of the difference of the shape cores.
+    class CoreSupport
+    {
+    private:
+        const skConvexShape& m_a;
+        const skConvexShape& m_b;
+
+    public:
+        CoreSupport(const skConvexShape& a, const skConvexShape& b) :
+            m_a(a),
+            m_b(b)
+        {
+        }
+
+        SK_INLINE Vertex operator()(const skVector3& dir) const
+        {
+            Vertex r;
+            r.a = m_a.coreSupport(dir);
+            r.b = m_b.coreSupport(-dir);
+            r.w = r.a - r.b;
+            r.d = dir;
+            return r;
+        }
+    };
+
+    // Closest point to the origin on the segment ab, as weights of a and b.
+    void segment(const skVector3& a, const skVector3& b, skScalar& la, skScalar& lb)
+    {
+        const skVector3 ab = b - a;
+        const skScalar  d  = ab.length2();
+
+        skScalar t = d > 0 ? -a.dot(ab) / d : 0;
+        t          = skClamp<skScalar>(t, 0, 1);
+
+        la = 1 - t;
+        lb = t;
+    }
+
+    // Closest point to the origin on the triangle abc, as weights of
+    // its corners, by Voronoi region.
+    void triangle(const skVector3& a, const skVector3& b, const skVector3& c, skScalar* l)
+    {
+        const skVector3 ab = b - a;
+        const skVector3 ac = c - a;
+
+        l[0] = l[1] = l[2] = 0;
+
+        const skScalar d1 = -ab.dot(a);
+        const skScalar d2 = -ac.dot(a);
+        if (d1 <= 0 && d2 <= 0)
+        {
+            l[0] = 1;
+            return;
+        }
+
+        const skScalar d3 = -ab.dot(b);
+        const skScalar d4 = -ac.dot(b);
+        if (d3 >= 0 && d4 <= d3)
+        {
+            l[1] = 1;
+            return;
+        }
+
+        const skScalar vc = d1 * d4 - d3 * d2;
+        if (vc <= 0 && d1 >= 0 && d3 <= 0)
+        {
+            segment(a, b, l[0], l[1]);
+            return;
+        }
+
+        const skScalar d5 = -ab.dot(c);
+        const skScalar d6 = -ac.dot(c);
+        if (d6 >= 0 && d5 <= d6)
+        {
+            l[2] = 1;
+            return;
+        }
+
+        const skScalar vb = d5 * d2 - d1 * d6;
+        if (vb <= 0 && d2 >= 0 && d6 <= 0)
+        {
+            segment(a, c, l[0], l[2]);
+            return;
+        }
+
+        const skScalar va = d3 * d6 - d5 * d4;
+        if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0)
+        {
+            segment(b, c, l[1], l[2]);
+            return;
+        }
+
+        const skScalar sum = va + vb + vc;
+        if (sum > 0)
+        {
+            l[1] = vb / sum;
+            l[2] = vc / sum;
+            l[0] = 1 - l[1] - l[2];
+            return;
+        }
+
+        // Degenerate, the corners are collinear. Take the best edge.
+        skScalar e[3][2];
+        segment(a, b, e[0][0], e[0][1]);
+        segment(a, c, e[1][0], e[1][1]);
+        segment(b, c, e[2][0], e[2][1]);
+
+        const skScalar dab = (a * e[0][0] + b * e[0][1]).length2();
+        const skScalar dac = (a * e[1][0] + c * e[1][1]).length2();
+        const skScalar dbc = (b * e[2][0] + c * e[2][1]).length2();
+
+        if (dab <= dac && dab <= dbc)
+            l[0] = e[0][0], l[1] = e[0][1];
+        else if (dac <= dbc)
+            l[0] = e[1][0], l[2] = e[1][1];
+        else
+            l[1] = e[2][0], l[2] = e[2][1];
+    }
+
+    // Closest point to the origin on the tetrahedron, as weights of its
+    // corners. Returns false when the origin is inside.
+    bool tetrahedron(const Simplex& s, skScalar* l)
+    {
+        static const SKuint32 Faces[4][4] = {
+            {0, 1, 2, 3},
+            {0, 2, 3, 1},
+            {0, 3, 1, 2},
+            {1, 3, 2, 0},
+        };
+
+        // A flat tetrahedron cannot hold the origin, and its face tests
+        // are only rounding noise, so every face is a candidate.
+        const skVector3 n0   = (s.v[1].w - s.v[0].w).cross(s.v[2].w - s.v[0].w);
+        const skVector3 h    = s.v[3].w - s.v[0].w;
+        const skScalar  vol  = n0.dot(h);
+        const bool      flat = vol * vol <= Relative * Relative * n0.length2() * h.length2();
+
+        bool     outside = false;
+        skScalar best    = SK_INFINITY;
+
+        for (const SKuint32* f : Faces)
+        {
+            const skVector3& a = s.v[f[0]].w;
+            const skVector3& b = s.v[f[1]].w;
+            const skVector3& c = s.v[f[2]].w;
+            const skVector3& d = s.v[f[3]].w;
+
+            // The origin and d on opposite sides of the face, or on it.
+            const skVector3 n = (b - a).cross(c - a);
+            if (!flat && n.dot(a) * n.dot(d - a) < 0)
+                continue;
+
+            outside = true;
+
+            skScalar t[3];
+            triangle(a, b, c, t);
+
+            const skScalar dist = (a * t[0] + b * t[1] + c * t[2]).length2();
+            if (dist < best)
+            {
+                best    = dist;
+                l[f[0]] = t[0];
+                l[f[1]] = t[1];
+                l[f[2]] = t[2];
+                l[f[3]] = 0;
+            }
+        }
+        return outside;
+    }
+
+    // Reduces the simplex to the smallest sub simplex that holds its
+    // closest point to the origin, and returns that point. A full
+    // tetrahedron is kept when it holds the origin.
+    skVector3 reduce(Simplex& s)
+    {
+        skScalar l[4] = {1, 0, 0, 0};
+
+        switch (s.n)
+        {
+        case 2:
+            segment(s.v[0].w, s.v[1].w, l[0], l[1]);
+            break;
+        case 3:
+            triangle(s.v[0].w, s.v[1].w, s.v[2].w, l);
+            break;
+        case 4:
+            if (!tetrahedron(s, l))
+                return skVector3::Zero;
+            break;
+        default:
+            break;
+        }
+
+        skVector3 p(0, 0, 0);
+        SKuint32  n = 0;
+        for (SKuint32 i = 0; i < s.n; ++i)
+        {
+            if (l[i] > 0)
+            {
+                s.v[n] = s.v[i];
+                s.l[n] = l[i];
+                p += s.v[i].w * l[i];
+                ++n;
+            }
+        }
+
+        if (n == 0)
+        {
+            s.l[0] = 1;
+            n      = 1;
+            p      = s.v[0].w;
+        }
+
+        s.n = n;
+        return p;
+    }
+
+    void witness(const Simplex& s, skVector3& pa, skVector3& pb)
+    {
+        pa = pb = skVector3::Zero;
+        for (SKuint32 i = 0; i < s.n; ++i)
+        {
+            pa += s.v[i].a * s.l[i];
+            pb += s.v[i].b * s.l[i];
+        }
+    }
+
+    void store(skGjkCache* cache, const Simplex& s)
+    {
+        if (!cache)
+            return;
+
+        for (SKuint32 i = 0; i < s.n; ++i)
+            cache->directions[i] = s.v[i].d;
+        cache->count = s.n;
+    }
+
+    // Runs GJK from the simplex of the last query in cache, with its
+    // directions queried again on the shapes as they are now, or from a
+    // single point when cold. Returns true when the origin is inside the
+    // difference, or within tolerance of it, and false with v its closest
+    // point otherwise. A non negative margin stops early once a plane
+    // shows the distance exceeds it.
+    bool gjk(Simplex&           s,
+             skVector3&         v,
+             const CoreSupport& support,
+             const skGjkCache*  cache,
+             skScalar           margin,
+             SKuint32&          iterations)
+    {
+        s.n = 0;
+        if (cache)
+        {
+            for (SKuint32 i = 0; i < cache->count && i < 4; ++i)
+            {
+                const Vertex w = support(cache->directions[i]);
+
+                bool known = false;
+                for (SKuint32 j = 0; j < s.n && !known; ++j)
+                    known = s.v[j].w == w.w;
+                if (!known)
+                    s.v[s.n++] = w;
+            }
+        }
+
+        if (s.n == 0)
+            s.v[s.n++] = support(-skVector3::UnitX);
+
+        v = reduce(s);
+        if (s.n == 4)
+            return true;
+
+        while (iterations < MaxIterations)
+        {
+            ++iterations;
+
+            const skScalar vv = v.length2();
+
+            skScalar ww = 0;
+            for (SKuint32 i = 0; i < s.n; ++i)
+                ww = skMax(ww, s.v[i].w.length2());
+            if (vv <= Relative * Relative * ww)
+                return true;
+
+            const Vertex   w  = support(-v);
+            const skScalar vw = v.dot(w.w);
+
+            if (margin >= 0 && vw > 0 && vw * vw > margin * margin * vv)
+                return false;
+            if (vv - vw <= Relative * vv)
+                return false;
+
+            for (SKuint32 i = 0; i < s.n; ++i)
+            {
+                if (s.v[i].w == w.w)
+                    return false;
+            }
+
+            // Rounding can make the new simplex no better than the last,
+            // in which case the last one is kept.
+            const Simplex last = s;
+
+            s.v[s.n++] = w;
+
+            const skVector3 p = reduce(s);
+            if (s.n == 4)
+                return true;
+
+            if (p.length2() >= vv)
+            {
+                s = last;
+                return false;
+            }
+            v = p;
+        }
+        return false;
+    }
+
+    // Grows a simplex that touches the origin into a tetrahedron. When
+    // the difference is flat the origin is on its boundary, and normal
+    // is set to a direction out of it.
+    bool fill(Simplex& s, const CoreSupport& support, skVector3& normal)
+    {
+        static const skVector3 Axes[6] = {
+            skVector3(1, 0, 0),
+            skVector3(-1, 0, 0),
+            skVector3(0, 1, 0),
+            skVector3(0, -1, 0),
+            skVector3(0, 0, 1),
+            skVector3(0, 0, -1),
+        };
+
+        skScalar scale = 0;
+        for (SKuint32 i = 0; i < s.n; ++i)
+            scale = skMax(scale, s.v[i].w.length2());
+
+        if (s.n == 1)
+        {
+            for (const skVector3& axis : Axes)
+            {
+                const Vertex w = support(axis);
+
+                scale = skMax(scale, w.w.length2());
+                if (w.w.distance2(s.v[0].w) > Relative * scale)
+                {
+                    s.v[s.n++] = w;
+                    break;
+                }
+            }
+
+            if (s.n == 1)
+            {
+                normal = skVector3::UnitX;
+                return false;
+            }
+        }
+
+        if (s.n == 2)
+        {
+            const skVector3 d = s.v[1].w - s.v[0].w;
+            const skVector3 a = d.abs();
+
+            skVector3 axis = skVector3::UnitZ;
+            if (a.x <= a.y && a.x <= a.z)
+                axis = skVector3::UnitX;
+            else if (a.y <= a.z)
+                axis = skVector3::UnitY;
+
+            const skVector3 p1 = d.cross(axis);
+            const skVector3 p2 = d.cross(p1);
+            const skVector3 dirs[4] = {p1, -p1, p2, -p2};
+
+            for (const skVector3& dir : dirs)
+            {
+                const Vertex w = support(dir);
+
+                scale = skMax(scale, w.w.length2());
+                if ((w.w - s.v[0].w).cross(d).length2() > Relative * scale * d.length2())
+                {
+                    s.v[s.n++] = w;
+                    break;
+                }
+            }
+
+            if (s.n == 2)
+            {
+                normal = p1.normalized();
+                return false;
+            }
+        }
+
+        if (s.n == 3)
+        {
+            const skVector3 n = (s.v[1].w - s.v[0].w).cross(s.v[2].w - s.v[0].w);
+            const skVector3 dirs[2] = {n, -n};
+
+            for (const skVector3& dir : dirs)
+            {
+                const Vertex   w   = support(dir);
+                const skScalar off = n.dot(w.w - s.v[0].w);
+
+                scale = skMax(scale, w.w.length2());
+                if (off * off > Relative * scale * n.length2())
+                {
+                    s.v[s.n++] = w;
+                    break;
+                }
+            }
+
+            if (s.n == 3)
+            {
+                normal = n.normalized();
+                if (normal.dot(s.v[0].w) < 0)
+                    normal = -normal;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Weights of the projection of p onto the plane of the triangle abc.
+    void barycentric(const skVector3& a, const skVector3& b, const skVector3& c, const skVector3& p, skScalar* l)
+    {
+        const skVector3 v0 = b - a;
+        const skVector3 v1 = c - a;
+        const skVector3 v2 = p - a;
+
+        const skScalar d00 = v0.dot(v0);
+        const skScalar d01 = v0.dot(v1);
+        const skScalar d11 = v1.dot(v1);
+        const skScalar d20 = v2.dot(v0);
+        const skScalar d21 = v2.dot(v1);
+        const skScalar den = d00 * d11 - d01 * d01;
+
+        if (den > 0)
+        {
+            l[1] = (d11 * d20 - d01 * d21) / den;
+            l[2] = (d00 * d21 - d01 * d20) / den;
+            l[0] = 1 - l[1] - l[2];
+        }
+        else
+        {
+            l[0] = 1;
+            l[1] = l[2] = 0;
+        }
+    }
+
+    class Polytope
+    {
+    public:
+        Vertex   verts[MaxEpaVertices];
+        Face     faces[MaxEpaFaces];
+        Edge     edges[MaxEpaEdges];
+        SKuint32 nv, nf, ne;
+
+        skVector3 inner;
+
+        bool addFace(SKuint32 i, SKuint32 j, SKuint32 k)
+        {
+            if (nf >= MaxEpaFaces)
+                return false;
+
+            const skVector3& a = verts[i].w;
+
+            Face& f = faces[nf++];
+            f.alive = true;
+            f.n     = (verts[j].w - a).cross(verts[k].w - a);
+
+            // Keep the winding outward, away from a point known to be
+            // inside.
+            if (f.n.dot(a - inner) < 0)
+            {
+                f.i = i, f.j = k, f.k = j;
+                f.n = -f.n;
+            }
+            else
+                f.i = i, f.j = j, f.k = k;
+
+            const skScalar len = f.n.length2();
+            if (len > 0)
+            {
+                f.n *= 1 / skSqrt(len);
+                f.d = f.n.dot(a);
+            }
+            else
+                f.d = SK_INFINITY;
+            return true;
+        }
+
+        void addEdge(SKuint32 a, SKuint32 b)
+        {
+            for (SKuint32 e = 0; e < ne; ++e)
+            {
+                if (edges[e].a == b && edges[e].b == a)
+                {
+                    edges[e] = edges[--ne];
+                    return;
+                }
+            }
+            if (ne < MaxEpaEdges)
+                edges[ne++] = {a, b};
+        }
+
+        void compact()
+        {
+            SKuint32 n = 0;
+            for (SKuint32 i = 0; i < nf; ++i)
+            {
+                if (faces[i].alive)
+                    faces[n++] = faces[i];
+            }
+            nf = n;
+        }
+    };
+
+    // Expanding polytope algorithm, from a tetrahedron that holds the
+    // origin. Finds the face of the difference closest to the origin.
+    void epa(const Simplex&     s,
+             const CoreSupport& support,
+             skVector3&         normal,
+             skScalar&          depth,
+             skVector3&         pa,
+             skVector3&         pb,
+             SKuint32&          iterations)
+    {
+        Polytope p;
+        p.nv = 4;
+        p.nf = 0;
+
+        skScalar scale = 0;
+        for (SKuint32 i = 0; i < 4; ++i)
+        {
+            p.verts[i] = s.v[i];
+            scale      = skMax(scale, s.v[i].w.length2());
+        }
+        const skScalar tolerance = Relative * skSqrt(scale);
+
+        p.inner = (p.verts[0].w + p.verts[1].w + p.verts[2].w + p.verts[3].w) * skScalar(0.25);
+
+        p.addFace(0, 1, 2);
+        p.addFace(0, 3, 1);
+        p.addFace(0, 2, 3);
+        p.addFace(1, 3, 2);
+
+        Face best = p.faces[0];
+
+        for (SKuint32 it = 0; it < MaxEpaIterations; ++it)
+        {
+            ++iterations;
+
+            p.compact();
+
+            SKuint32 closest = 0;
+            for (SKuint32 i = 1; i < p.nf; ++i)
+            {
+                if (p.faces[i].d < p.faces[closest].d)
+                    closest = i;
+            }
+
+            best = p.faces[closest];
+
+            // The closest face is on the boundary when the support point
+            // gets no further out, or is one of the vertices again.
+            const Vertex w = support(best.n);
+            if (best.n.dot(w.w) - best.d <= tolerance)
+                break;
+
+            bool known = false;
+            for (SKuint32 i = 0; i < p.nv && !known; ++i)
+                known = w.w.distance2(p.verts[i].w) <= tolerance * tolerance;
+
+            if (known || p.nv >= MaxEpaVertices)
+                break;
+
+            // Faces within tolerance of w stay, so rounding cannot open
+            // a hole in the polytope.
+            const SKuint32 idx = p.nv;
+
+            p.verts[p.nv++] = w;
+            p.ne            = 0;
+
+            for (SKuint32 i = 0; i < p.nf; ++i)
+            {
+                Face& f = p.faces[i];
+                if (f.n.dot(w.w - p.verts[f.i].w) > tolerance)
+                {
+                    f.alive = false;
+                    p.addEdge(f.i, f.j);
+                    p.addEdge(f.j, f.k);
+                    p.addEdge(f.k, f.i);
+                }
+            }
+
+            bool full = p.ne == 0;
+            for (SKuint32 e = 0; e < p.ne && !full; ++e)
+                full = !p.addFace(p.edges[e].a, p.edges[e].b, idx);
+
+            // Out of room. best is still the closest face of the last
+            // whole polytope, and its vertices are unchanged.
+            if (full)
+                break;
+        }
+
+        normal = best.n;
+        depth  = skMax<skScalar>(best.d, 0);
+
+        skScalar l[3];
+        barycentric(p.verts[best.i].w, p.verts[best.j].w, p.verts[best.k].w, best.n * best.d, l);
+
+        pa = p.verts[best.i].a * l[0] + p.verts[best.j].a * l[1] + p.verts[best.k].a * l[2];
+        pb = p.verts[best.i].b * l[0] + p.verts[best.j].b * l[1] + p.verts[best.k].b * l[2];
+    }
+}  // namespace
+
+bool skGjk::intersect(const skConvexShape& a, const skConvexShape& b, skGjkCache* cache)
+{
+    const skScalar    m = a.margin() + b.margin();
+    const CoreSupport core(a, b);
+
+    Simplex   s;
+    skVector3 v;
+    SKuint32  iterations = 0;
+
+    const bool hit = gjk(s, v, core, cache, m, iterations) || v.length2() <= m * m;
+
+    store(cache, s);
+    return hit;
+}
+
+bool skGjk::collide(skGjkResult& result, const skConvexShape& a, const skConvexShape& b, skGjkCache* cache)
+{
+    const skScalar    ra = a.margin();
+    const skScalar    rb = b.margin();
+    const CoreSupport core(a, b);
+
+    Simplex   s;
+    skVector3 v;
+
+    result.iterations = 0;
+
+    skVector3 n, pa, pb;
+    skScalar  d;
+
+    if (!gjk(s, v, core, cache, -1, result.iterations))
+    {
+        // The cores are apart, the margins may still overlap.
+        d = v.length();
+        n = v * (-1 / d);
+        witness(s, pa, pb);
+    }
+    else
+    {
+        Simplex flat = s;
+        if (fill(s, core, n))
+            epa(s, core, n, d, pa, pb, result.iterations);
+        else
+        {
+            d = 0;
+            witness(flat, pa, pb);
+        }
+        d = -d;
+    }
+
+    store(cache, s);
+
+    result.distance     = d - ra - rb;
+    result.intersecting = result.distance <= 0;
+    result.normal       = n;
+    result.pointA       = pa + n * ra;
+    result.pointB       = pb - n * rb;
+    return result.intersecting;
+}
+
+void skGjk::collide(skGjkResult*         results,
+                    const skConvexShape* a,
+                    const skConvexShape* b,
+                    SKuint32             count,
+                    skGjkCache*          caches,
+                    SKuint32             threads)
+{
+    skParallel::forChunks(
+        count,
+        Grain,
+        [=](SKsize, SKsize first, SKsize last) {
+            for (SKsize i = first; i < last; ++i)
+                collide(results[i], a[i], b[i], caches ? caches + i : nullptr);
+        },
+        threads);
+}
@@ -0,0 +1,114 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skGjk_h_
+#define _skGjk_h_
+
+#include "skConvexShape.h"
+
+/// <summary>
+/// Warm start state for one pair of shapes, kept by the caller from one
+/// step to the next.
+/// </summary>
+struct skGjkCache
+{
+    skGjkCache() :
+        count(0)
+    {
+    }
+
+    /// <summary>
+    /// The search directions whose support points made up the final
+    /// simplex of the last query. The next query asks the moved shapes
+    /// for the same directions and starts from that simplex.
+    /// </summary>
+    skVector3 directions[4];
+
+    /// <summary>
+    /// The number of directions in use, or zero when cold.
+    /// </summary>
+    SKuint32 count;
+};
+
+struct skGjkResult
+{
+    skGjkResult() :
+        intersecting(false),
+        distance(0),
+        iterations(0)
+    {
+    }
+
+    bool intersecting;
+
+    /// <summary>
+    /// The separation, or minus the penetration depth.
+    /// </summary>
+    skScalar distance;
+
+    /// <summary>
+    /// Unit vector from A towards B. Moving B by -distance along it
+    /// brings the shapes into touching contact.
+    /// </summary>
+    skVector3 normal;
+
+    /// <summary>
+    /// The closest, or deepest, points on the surfaces of A and B.
+    /// </summary>
+    skVector3 pointA;
+    skVector3 pointB;
+
+    SKuint32 iterations;
+};
+
+/// <summary>
+/// Gilbert-Johnson-Keerthi distance and intersection queries, with the
+/// expanding polytope algorithm for the penetration depth. The margins
+/// of spheres and capsules are handled analytically around their cores,
+/// so EPA only runs when the cores themselves overlap.
+/// </summary>
+class skGjk
+{
+public:
+    /// <summary>
+    /// Boolean test. Stops as soon as a separating plane is found.
+    /// </summary>
+    static bool intersect(const skConvexShape& a, const skConvexShape& b, skGjkCache* cache = nullptr);
+
+    /// <summary>
+    /// Fills result with the distance, or the penetration, and the contact
+    /// frame. Returns result.intersecting.
+    /// </summary>
+    static bool collide(skGjkResult& result, const skConvexShape& a, const skConvexShape& b, skGjkCache* cache = nullptr);
+
+    /// <summary>
+    /// Batch form of collide over count pairs (a[i], b[i]), split over
+    /// up to threads workers. caches may be null.
+    /// </summary>
+    static void collide(skGjkResult*         results,
+                        const skConvexShape* a,
+                        const skConvexShape* b,
+                        SKuint32             count,
+                        skGjkCache*          caches  = nullptr,
+                        SKuint32             threads = 0);
+};
+
+#endif  //_skGjk_h_
@@ -0,0 +1,250 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skKdTree.h"
+#include <algorithm>
+#include "skFrameArena.h"
+#include "skParallel.h"
+
+namespace
+{
+    // Smallest range worth a thread during build.
+    const SKuint32 BuildGrain = 65536;
+
+    // Queries per worker before threads pay off.
+    const SKsize QueryGrain = 256;
+}  // namespace
+
+struct skKdTree::Entry
+{
+    skVector3 p;
+    SKuint32  id;
+};
+
+// The k best candidates so far, sorted by distance.
+struct skKdTree::Neighbors
+{
+    SKuint32  k;
+    SKuint32  n;
+    SKuint32* idx;
+    skScalar* d2;
+
+    SK_INLINE skScalar worst() const
+    {
+        return n < k ? SK_INFINITY : d2[n - 1];
+    }
+
+    SK_INLINE void insert(SKuint32 id, skScalar d)
+    {
+        SKuint32 i = n < k ? n++ : k - 1;
+        while (i > 0 && d2[i - 1] > d)
+        {
+            d2[i]  = d2[i - 1];
+            idx[i] = idx[i - 1];
+            --i;
+        }
+        d2[i]  = d;
+        idx[i] = id;
+    }
+};
+
+skKdTree::skKdTree() :
+    m_threads(0),
+    m_parallelDepth(0)
+{
+}
+
+void skKdTree::build(const skVector3* points, SKuint32 count)
+{
+    // The entries only live for the build, so they come from the frame
+    // arena of this thread.
+    skFrameArena&             arena = skFrameArena::local();
+    const skFrameArena::Scope scope(arena);
+
+    const skSpan<Entry> entries = arena.allocate<Entry>(count);
+    for (SKuint32 i = 0; i < count; ++i)
+        entries[i] = {points[i], i};
+
+    m_axis.assign(count, 0);
+
+    const SKuint32 threads = m_threads > 0 ? m_threads : skParallel::threadCount();
+
+    m_parallelDepth = 0;
+    while ((SKuint32(1) << m_parallelDepth) < threads)
+        ++m_parallelDepth;
+
+    build(entries.data(), 0, count, 0);
+
+    m_points.resize(count);
+    m_indices.resize(count);
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        m_points[i]  = entries[i].p;
+        m_indices[i] = entries[i].id;
+    }
+}
+
+void skKdTree::build(Entry* entries, SKuint32 lo, SKuint32 hi, int depth)
+{
+    if (hi - lo <= LeafSize)
+        return;
+
+    // Split the axis with the largest extent.
+    skVector3 a = entries[lo].p, b = entries[lo].p;
+    for (SKuint32 i = lo + 1; i < hi; ++i)
+    {
+        const skVector3& p = entries[i].p;
+        a = skVector3(skMin(a.x, p.x), skMin(a.y, p.y), skMin(a.z, p.z));
+        b = skVector3(skMax(b.x, p.x), skMax(b.y, p.y), skMax(b.z, p.z));
+    }
+
+    const skVector3 e    = b - a;
+    const SKuint8   axis = e.x >= e.y && e.x >= e.z ? 0 : (e.y >= e.z ? 1 : 2);
+    const SKuint32  mid  = lo + (hi - lo) / 2;
+
+    std::nth_element(entries + lo, entries + mid, entries + hi, [axis](const Entry& l, const Entry& r) {
+        return l.p.ptr()[axis] < r.p.ptr()[axis];
+    });
+
+    m_axis[mid] = axis;
+
+    if (depth < m_parallelDepth && hi - lo > BuildGrain)
+    {
+        skParallel::invoke([=] { build(entries, lo, mid, depth + 1); },
+                           [=] { build(entries, mid + 1, hi, depth + 1); });
+    }
+    else
+    {
+        build(entries, lo, mid, depth + 1);
+        build(entries, mid + 1, hi, depth + 1);
+    }
+}
+
+void skKdTree::search(SKuint32 lo, SKuint32 hi, const skVector3& q, Neighbors& n) const
+{
+    if (hi - lo <= LeafSize)
+    {
+        for (SKuint32 i = lo; i < hi; ++i)
+        {
+            const skScalar d = m_points[i].distance2(q);
+            if (d < n.worst())
+                n.insert(m_indices[i], d);
+        }
+        return;
+    }
+
+    const SKuint32 mid  = lo + (hi - lo) / 2;
+    const int      axis = m_axis[mid];
+    const skScalar diff = q.ptr()[axis] - m_points[mid].ptr()[axis];
+
+    const skScalar d = m_points[mid].distance2(q);
+    if (d < n.worst())
+        n.insert(m_indices[mid], d);
+
+    if (diff <= 0)
+    {
+        search(lo, mid, q, n);
+        if (diff * diff < n.worst())
+            search(mid + 1, hi, q, n);
+    }
+    else
+    {
+        search(mid + 1, hi, q, n);
+        if (diff * diff < n.worst())
+            search(lo, mid, q, n);
+    }
+}
+
+void skKdTree::search(SKuint32 lo, SKuint32 hi, const skVector3& q, skScalar r2, std::vector<SKuint32>& out) const
+{
+    if (hi - lo <= LeafSize)
+    {
+        for (SKuint32 i = lo; i < hi; ++i)
+        {
+            if (m_points[i].distance2(q) <= r2)
+                out.push_back(m_indices[i]);
+        }
+        return;
+    }
+
+    const SKuint32 mid  = lo + (hi - lo) / 2;
+    const int      axis = m_axis[mid];
+    const skScalar diff = q.ptr()[axis] - m_points[mid].ptr()[axis];
+
+    if (m_points[mid].distance2(q) <= r2)
+        out.push_back(m_indices[mid]);
+
+    if (diff <= 0 || diff * diff <= r2)
+        search(lo, mid, q, r2, out);
+    if (diff >= 0 || diff * diff <= r2)
+        search(mid + 1, hi, q, r2, out);
+}
+
+SKuint32 skKdTree::nearest(const skVector3& query, skScalar& distanceSquared) const
+{
+    SKuint32 index  = Invalid;
+    distanceSquared = SK_INFINITY;
+    nearest(query, 1, &index, &distanceSquared);
+    return index;
+}
+
+SKuint32 skKdTree::nearest(const skVector3& query, SKuint32 k, SKuint32* indices, skScalar* distancesSquared) const
+{
+    if (k == 0)
+        return 0;
+
+    Neighbors n = {k, 0, indices, distancesSquared};
+    search(0, size(), query, n);
+    return n.n;
+}
+
+void skKdTree::nearest(const skVector3* queries,
+                       SKuint32         count,
+                       SKuint32         k,
+                       SKuint32*        indices,
+                       skScalar*        distancesSquared) const
+{
+    skParallel::forChunks(
+        count,
+        QueryGrain,
+        [&](SKsize, SKsize first, SKsize last) {
+            for (SKsize i = first; i < last; ++i)
+            {
+                SKuint32* idx = indices + i * k;
+                skScalar* d2  = distancesSquared + i * k;
+
+                for (SKuint32 j = nearest(queries[i], k, idx, d2); j < k; ++j)
+                {
+                    idx[j] = Invalid;
+                    d2[j]  = SK_INFINITY;
+                }
+            }
+        },
+        m_threads);
+}
+
+SKsize skKdTree::radius(std::vector<SKuint32>& out, const skVector3& center, skScalar radius) const
+{
+    const SKsize before = out.size();
+    if (!m_points.empty())
+        search(0, size(), center, radius * radius, out);
+    return out.size() - before;
+}
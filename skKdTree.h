@@ -0,0 +1,109 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skKdTree_h_
+#define _skKdTree_h_
+
+#include <vector>
+#include "skVector3.h"
+
+/// <summary>
+/// Static kd-tree over a point cloud. The tree is implicit: build()
+/// reorders the points so that every range [lo, hi) stores its median
+/// split point at (lo + hi) / 2 with the lower half before it, and only
+/// the split axis of each range is kept on the side. Ranges of LeafSize
+/// points or less are scanned linearly.
+/// </summary>
+class skKdTree
+{
+public:
+    static constexpr SKuint32 LeafSize = 8;
+
+    /// <summary>
+    /// Marks the unused slots of a k-NN result.
+    /// </summary>
+    static constexpr SKuint32 Invalid = 0xFFFFFFFF;
+
+public:
+    skKdTree();
+
+    /// <summary>
+    /// Limits the workers used by build and the batch queries. Zero uses
+    /// every hardware thread.
+    /// </summary>
+    void setThreadCount(SKuint32 threads)
+    {
+        m_threads = threads;
+    }
+
+    void build(const skVector3* points, SKuint32 count);
+
+    SKuint32 size() const
+    {
+        return (SKuint32)m_points.size();
+    }
+
+    /// <summary>
+    /// Returns the original index of the closest point and its squared
+    /// distance, or Invalid when the tree is empty.
+    /// </summary>
+    SKuint32 nearest(const skVector3& query, skScalar& distanceSquared) const;
+
+    /// <summary>
+    /// Finds the k closest points, writing their original indices and
+    /// squared distances in increasing order of distance. Returns the
+    /// number found, which is less than k only for small trees.
+    /// </summary>
+    SKuint32 nearest(const skVector3& query, SKuint32 k, SKuint32* indices, skScalar* distancesSquared) const;
+
+    /// <summary>
+    /// Batch form of the k-NN query. Query i writes to indices[i * k] and
+    /// distancesSquared[i * k]; missing neighbors are Invalid with an
+    /// infinite distance.
+    /// </summary>
+    void nearest(const skVector3* queries,
+                 SKuint32         count,
+                 SKuint32         k,
+                 SKuint32*        indices,
+                 skScalar*        distancesSquared) const;
+
+    /// <summary>
+    /// Appends the original indices of the points within radius of
+    /// center to out and returns how many were added.
+    /// </summary>
+    SKsize radius(std::vector<SKuint32>& out, const skVector3& center, skScalar radius) const;
+
+private:
+    struct Entry;
+    struct Neighbors;
+
+    void build(Entry* entries, SKuint32 lo, SKuint32 hi, int depth);
+    void search(SKuint32 lo, SKuint32 hi, const skVector3& q, Neighbors& n) const;
+    void search(SKuint32 lo, SKuint32 hi, const skVector3& q, skScalar r2, std::vector<SKuint32>& out) const;
+
+    SKuint32               m_threads;
+    int                    m_parallelDepth;
+    std::vector<skVector3> m_points;
+    std::vector<SKuint32>  m_indices;
+    std::vector<SKuint8>   m_axis;
+};
+
+#endif  //_skKdTree_h_
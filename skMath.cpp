@@ -22,6 +22,7 @@
 #include "skMath.h"
 #include "skMatrix3.h"
 #include "skMatrix4.h"
+#include "skSimdDispatch.h"
 #include "skTransform2D.h"
 
 void skMath::ortho2D(class skTransform2D& dest, skScalar l, skScalar t, skScalar r, skScalar b)
@@ -48,7 +49,7 @@ void skMath::ortho2D(class skTransform2D& dest, skScalar l, skScalar t, skScalar
         1);
 }
 
-void skMath::ortho2D(class skMatrix4& dest, skScalar l, skScalar t, skScalar r, skScalar b)
+void skMath::ortho2D(skMatrix4& dest, skScalar l, skScalar t, skScalar r, skScalar b)
 {
     skScalar dx = r - l, dy = b - t;
 
@@ -111,7 +112,7 @@ void skMath::view(skMatrix4& dest, const skVector3& pos, const skQuaternion& rot
     view(dest, pos, m3);
 }
 
-void skMath::view(skMatrix4& dest, const class skVector3& pos, const class skMatrix3& rot)
+void skMath::view(skMatrix4& dest, const skVector3& pos, const class skMatrix3& rot)
 {
     dest.m[0][0] = rot.m[0][0];
     dest.m[0][1] = rot.m[1][0];
@@ -145,6 +146,31 @@ skScalar skMath::wrap2Pi(skScalar x)
     return x - 2 * skFloor(x * skInvPi2) * skPi;
 }
 
+skScalar skMath::wrapPi(skScalar x)
+{
+    return x - 2 * skFloor(x * skInvPi2 + skScalar(0.5)) * skPi;
+}
+
+void skMath::wrap2Pi(skScalar* dst, const skScalar* src, SKsize count)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    i = skSimdDispatch::kernels().wrap2Pi(dst, src, count);
+#endif
+    for (; i < count; ++i)
+        dst[i] = wrap2Pi(src[i]);
+}
+
+void skMath::wrapPi(skScalar* dst, const skScalar* src, SKsize count)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    i = skSimdDispatch::kernels().wrapPi(dst, src, count);
+#endif
+    for (; i < count; ++i)
+        dst[i] = wrapPi(src[i]);
+}
+
 int skMath::pow2(int n)
 {
     --n;
@@ -159,8 +185,39 @@ int skMath::pow2(int n)
 
 void skMath::sinCos(const skScalar& theta, skScalar& y, skScalar& x)
 {
+#if defined(SK_FAST_MATH) && !defined(SK_DOUBLE)
+    skFastMath::sinCos(theta, y, x);
+#else
     x = skCos(theta);
     y = skSin(theta);
+#endif
+}
+
+void skMath::sinCos(const skScalar* theta, skScalar* y, skScalar* x, SKsize count)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    for (i = skSimdDispatch::kernels().sinCos(theta, y, x, count); i < count; ++i)
+        skFastMath::sinCos(theta[i], y[i], x[i]);
+#else
+    for (; i < count; ++i)
+    {
+        x[i] = skCos(theta[i]);
+        y[i] = skSin(theta[i]);
+    }
+#endif
+}
+
+void skMath::atan2(skScalar* dst, const skScalar* y, const skScalar* x, SKsize count)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    for (i = skSimdDispatch::kernels().atan2(dst, y, x, count); i < count; ++i)
+        dst[i] = skFastMath::atan2(y[i], x[i]);
+#else
+    for (; i < count; ++i)
+        dst[i] = std::atan2(y[i], x[i]);
+#endif
 }
 
 void skMath::forceAlign(skScalar& val, int mod)
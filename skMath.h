@@ -22,10 +22,13 @@
 #ifndef _skMath_h_
 #define _skMath_h_
 
+#include "skFastMath.h"
 #include "skScalar.h"
+#include <limits>
 
 #ifdef SK_DOUBLE
 #define skSqrt (skScalar) sqrt
+#define skRSqrt(x) (skScalar(1.0) / (skScalar)sqrt(x))
 #define skInvSqrt (skScalar)1.0 / (skScalar)sqrt
 #define skFloor (skScalar) floor
 #define skCeil (skScalar) ceil
@@ -43,39 +46,48 @@
 #define skFmod (skScalar) fmod
 #else
 #define skSqrt (skScalar) sqrtf
-#define skRSqrt(x) (powf((x), -0.5f))
 #define skFloor (skScalar) floorf
 #define skCeil (skScalar) ceilf
-#define skSin (skScalar) sinf
-#define skCos (skScalar) cosf
 #define skTan (skScalar) tanf
-#define skExp (skScalar) expf
-#define skLog (skScalar) logf
 #define skPow (skScalar) powf
 #define skMod (skScalar) fmodf
 #define skASin (skScalar) asinf
 #define skACos (skScalar) acosf
 #define skATan (skScalar) atanf
-#define skATan2 (skScalar) atan2f
 #define skFmod (skScalar) fmodf
+#ifdef SK_FAST_MATH
+#define skRSqrt skFastMath::rsqrt
+#define skSin skFastMath::sin
+#define skCos skFastMath::cos
+#define skExp skFastMath::exp
+#define skLog skFastMath::log
+#define skATan2 skFastMath::atan2
+#else
+#define skRSqrt(x) (skScalar(1.0) / (skScalar)sqrtf(x))
+#define skSin (skScalar) sinf
+#define skCos (skScalar) cosf
+#define skExp (skScalar) expf
+#define skLog (skScalar) logf
+#define skATan2 (skScalar) atan2f
+#endif
 #endif
 
-SK_INLINE skScalar skAbs(const skScalar& v)
+SK_INLINE constexpr skScalar skAbs(const skScalar& v)
 {
     return v < 0 ? -v : v;
 }
 
-SK_INLINE skScalar skSqu(const skScalar& v)
+SK_INLINE constexpr skScalar skSqu(const skScalar& v)
 {
     return v * v;
 }
 
-SK_INLINE skScalar skSign(const skScalar& v)
+SK_INLINE constexpr skScalar skSign(const skScalar& v)
 {
     return v > 0 ? skScalar(1.) : skScalar(-1.);
 }
 
-SK_INLINE skScalar skIsInf(const skScalar v)
+SK_INLINE constexpr skScalar skIsInf(const skScalar v)
 {
     return skAbs(v) >= SK_INFINITY;
 }
@@ -96,76 +108,154 @@ SK_INLINE void skSplitScalar(const skScalar v, skScalar& whole, skScalar& decima
     decimal = v - whole;
 }
 
-SK_INLINE bool skIsZero(const skScalar v)
+SK_INLINE constexpr bool skIsZero(const skScalar v)
 {
     return skAbs(v) < SK_EPSILON;
 }
 
-SK_INLINE bool skIsZero(skScalar v, skScalar tol)
+SK_INLINE constexpr bool skIsZero(skScalar v, skScalar tol)
 {
     return skAbs(v) < tol;
 }
 
-SK_INLINE bool skEq(skScalar x, skScalar y)
+SK_INLINE constexpr bool skEq(skScalar x, skScalar y)
 {
     return skAbs(x - y) < SK_EPSILON;
 }
 
-SK_INLINE skScalar skClampf(const skScalar& v, const skScalar& vMin, const skScalar& vMax)
+SK_INLINE constexpr skScalar skClampf(const skScalar& v, const skScalar& vMin, const skScalar& vMax)
 {
     return v < vMin ? vMin : v > vMax ? vMax : v;
 }
 
 
-SK_INLINE bool skNeq(skScalar x, skScalar y)
+SK_INLINE constexpr bool skNeq(skScalar x, skScalar y)
 {
     return !skEq(x, y);
 }
 
-SK_INLINE bool skEqT(skScalar x, skScalar y, skScalar tol)
+SK_INLINE constexpr bool skEqT(skScalar x, skScalar y, skScalar tol)
 {
     return skAbs(x - y) < tol;
 }
 
 
-const skScalar skPi     = skScalar(4.0 * skATan(1.0));
-const skScalar skPi4    = skScalar(4.0) * skPi;
-const skScalar skPi2    = skScalar(2.0) * skPi;
-const skScalar skPiH    = skScalar(0.5) * skPi;            // 90
-const skScalar skPiO3   = skScalar(skPi) / skScalar(3.0);  // 60
-const skScalar skPiO4   = skScalar(skPi) / skScalar(4.0);  // 45
-const skScalar skPiO6   = skScalar(skPi) / skScalar(6.0);  // 30
-const skScalar skDPR    = skScalar(180.0) / skPi;
-const skScalar skRPD    = skScalar(1.0) / skDPR;
-const skScalar skInvPi  = skScalar(1.0) / skPi;
-const skScalar skInvPi2 = skScalar(1.0) / skPi2;
+constexpr skScalar skPi     = skScalar(3.14159265358979323846);
+constexpr skScalar skPi4    = skScalar(4.0) * skPi;
+constexpr skScalar skPi2    = skScalar(2.0) * skPi;
+constexpr skScalar skPiH    = skScalar(0.5) * skPi;            // 90
+constexpr skScalar skPiO3   = skScalar(skPi) / skScalar(3.0);  // 60
+constexpr skScalar skPiO4   = skScalar(skPi) / skScalar(4.0);  // 45
+constexpr skScalar skPiO6   = skScalar(skPi) / skScalar(6.0);  // 30
+constexpr skScalar skDPR    = skScalar(180.0) / skPi;
+constexpr skScalar skRPD    = skScalar(1.0) / skDPR;
+constexpr skScalar skInvPi  = skScalar(1.0) / skPi;
+constexpr skScalar skInvPi2 = skScalar(1.0) / skPi2;
 
-SK_INLINE skScalar skDegrees(skScalar v)
+SK_INLINE constexpr skScalar skDegrees(skScalar v)
 {
     return v * skDPR;
 }
 
-SK_INLINE skScalar skRadians(skScalar v)
+SK_INLINE constexpr skScalar skRadians(skScalar v)
 {
     return v * skRPD;
 }
 
+/// <summary>
+/// Provides the scalar functions used by the templated types, so that
+/// their precision does not depend on the global skScalar type.
+/// </summary>
+template <typename T>
+class skScalarT
+{
+public:
+    static constexpr T Epsilon = std::numeric_limits<T>::epsilon();
+
+    SK_INLINE static constexpr T abs(const T v)
+    {
+        return v < 0 ? -v : v;
+    }
+
+    SK_INLINE static constexpr bool isZero(const T v)
+    {
+        return abs(v) < Epsilon;
+    }
+
+    SK_INLINE static constexpr bool eq(const T x, const T y)
+    {
+        return abs(x - y) < Epsilon;
+    }
+
+    SK_INLINE static T sqrt(const T v)
+    {
+        return std::sqrt(v);
+    }
+
+    SK_INLINE static T rsqrt(const T v)
+    {
+#ifdef SK_FAST_MATH
+        return skFastMath::rsqrt(v);
+#else
+        return T(1) / std::sqrt(v);
+#endif
+    }
+};
+
+template <typename T>
+class skVector3T;
+
+template <typename T>
+class skMatrix4T;
+
+typedef skVector3T<skScalar> skVector3;
+typedef skVector3T<float>    skVector3f;
+typedef skVector3T<double>   skVector3d;
+typedef skMatrix4T<skScalar> skMatrix4;
+typedef skMatrix4T<float>    skMatrix4f;
+typedef skMatrix4T<double>   skMatrix4d;
+
 class skMath
 {
 public:
     static void ortho2D(class skTransform2D& dest, skScalar l, skScalar t, skScalar r, skScalar b);
-    static void ortho2D(class skMatrix4& dest, skScalar l, skScalar t, skScalar r, skScalar b);
-    static void projection(class skMatrix4& dest, skScalar fov, skScalar aspect, skScalar zNear, skScalar zFar);
+    static void ortho2D(skMatrix4& dest, skScalar l, skScalar t, skScalar r, skScalar b);
+    static void projection(skMatrix4& dest, skScalar fov, skScalar aspect, skScalar zNear, skScalar zFar);
 
-    static void view(class skMatrix4& dest, const class skVector3& pos, const class skQuaternion& rot);
-    static void view(class skMatrix4& dest, const class skVector3& pos, const class skMatrix3& rot);
+    static void view(skMatrix4& dest, const skVector3& pos, const class skQuaternion& rot);
+    static void view(skMatrix4& dest, const skVector3& pos, const class skMatrix3& rot);
 
     static int  pow2(int n);
     static void forceAlign(skScalar& val, int mod);
 
     static skScalar wrap2Pi(skScalar x);
+    static skScalar wrapPi(skScalar x);
     static void     sinCos(const skScalar& theta, skScalar& y, skScalar& x);
 
+    /// <summary>
+    /// Wraps count angles from src into [0, 2pi). dst may equal src.
+    /// </summary>
+    static void wrap2Pi(skScalar* dst, const skScalar* src, SKsize count);
+
+    /// <summary>
+    /// Wraps count angles from src into [-pi, pi). dst may equal src.
+    /// </summary>
+    static void wrapPi(skScalar* dst, const skScalar* src, SKsize count);
+
+    /// <summary>
+    /// Computes y = sin(theta) and x = cos(theta) for count angles, sharing
+    /// the range reduction between the pair. Single precision always uses
+    /// the skFastMath kernel at the width skSimdDispatch picks, see
+    /// skFastMath.h for its bounds.
+    /// </summary>
+    static void sinCos(const skScalar* theta, skScalar* y, skScalar* x, SKsize count);
+
+    /// <summary>
+    /// Computes dst = atan2(y, x) for count pairs. Single precision uses
+    /// the skFastMath kernel at the width skSimdDispatch picks.
+    /// </summary>
+    static void atan2(skScalar* dst, const skScalar* y, const skScalar* x, SKsize count);
+
     static skScalar toMillimeters(const skScalar& deg);
     static skScalar toFieldOfView(const skScalar& mm);
 };
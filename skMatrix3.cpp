@@ -20,10 +20,306 @@
 -------------------------------------------------------------------------------
 */
 #include "skMatrix3.h"
+#include <cfloat>
 #include <cstdio>
+#include "skFastMath.h"
 
-const skMatrix3 skMatrix3::Identity = skMatrix3(1, 0, 0, 0, 1, 0, 0, 0, 1);
-const skMatrix3 skMatrix3::Zero     = skMatrix3(0, 0, 0, 0, 0, 0, 0, 0, 0);
+namespace
+{
+    // McAdams et al., "Computing the Singular Value Decomposition of 3x3
+    // matrices with minimal branching and elementary floating point
+    // operations". Cyclic Jacobi sweeps diagonalize A^T A into V, then a
+    // Givens QR of A V gives U and the singular values. The Jacobi
+    // rotations are exact rather than the paper's pi/8 clamped estimates,
+    // which converge too slowly on some inputs for a fixed sweep count.
+    // Every decision is a select, so the same kernel runs on float,
+    // double and the lanes of skSimd4f.
+
+    template <typename F>
+    struct SvdTraits;
+
+    template <>
+    struct SvdTraits<float>
+    {
+        static constexpr int   Sweeps  = 4;
+        static constexpr float Epsilon = 1e-6f;
+        static constexpr float Tiny    = 1e-12f;
+        static constexpr float Min     = FLT_MIN;
+    };
+
+    template <>
+    struct SvdTraits<skSimd4f> : SvdTraits<float>
+    {
+    };
+
+    template <>
+    struct SvdTraits<double>
+    {
+        static constexpr int    Sweeps  = 5;
+        static constexpr double Epsilon = 1e-15;
+        static constexpr double Tiny    = 1e-30;
+        static constexpr double Min     = DBL_MIN;
+    };
+
+    // Applies the rotation in the (P, Q) plane to the columns of m.
+    template <int P, int Q, typename F>
+    SK_INLINE void rotateColumns(F (&m)[3][3], const F& c, const F& s)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const F mp = m[i][P];
+            m[i][P]    = c * mp + s * m[i][Q];
+            m[i][Q]    = c * m[i][Q] - s * mp;
+        }
+    }
+
+    // Applies the transposed rotation in the (P, Q) plane to the rows of m.
+    template <int P, int Q, typename F>
+    SK_INLINE void rotateRows(F (&m)[3][3], const F& c, const F& s)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            const F mp = m[P][j];
+            m[P][j]    = c * mp + s * m[Q][j];
+            m[Q][j]    = c * m[Q][j] - s * mp;
+        }
+    }
+
+    // One Jacobi step on the symmetric matrix s, zeroing s[P][Q]. The
+    // rotation angle is half of atan2(2 s_pq, s_pp - s_qq), found without
+    // trigonometry from the normalized half angle vector.
+    template <int P, int Q, typename F>
+    SK_INLINE void jacobi(F (&s)[3][3], F (&v)[3][3])
+    {
+        const F eps(SvdTraits<F>::Epsilon);
+
+        // Off diagonals below the rounding error of forming A^T A are
+        // left alone, otherwise their squares reach into denormals.
+        const F d    = s[P][P] - s[Q][Q];
+        const F tiny = F(SvdTraits<F>::Tiny);
+        const F o    = skSimdSelect(skSimdAbs(s[P][Q]) > tiny, F(2.f) * s[P][Q], F(0.f));
+        const F r    = skSimdSqrt(d * d + o * o);
+
+        F ch = skSimdAbs(d) + skSimdMax(r, eps);
+        F sh = o;
+
+        const auto neg = d < F(0.f);
+        const F    t   = ch;
+
+        ch = skSimdSelect(neg, sh, ch);
+        sh = skSimdSelect(neg, t, sh);
+
+        const F w  = skFastMath::rsqrt(ch * ch + sh * sh);
+        const F c  = ch * w;
+        const F sn = sh * w;
+
+        rotateColumns<P, Q>(s, c, sn);
+        rotateRows<P, Q>(s, c, sn);
+        rotateColumns<P, Q>(v, c, sn);
+    }
+
+    // Orders the keys n[I] >= n[J] and returns where they were swapped.
+    template <int I, int J, typename F>
+    SK_INLINE auto sortKeys(F (&n)[3])
+    {
+        const auto swap = n[I] < n[J];
+        const F    ni   = n[I];
+
+        n[I] = skSimdSelect(swap, n[J], ni);
+        n[J] = skSimdSelect(swap, ni, n[J]);
+        return swap;
+    }
+
+    // Swaps columns I and J of m where requested, negating one of them so
+    // that a rotation stays a rotation.
+    template <int I, int J, typename F, typename M>
+    SK_INLINE void swapColumns(F (&m)[3][3], const M& swap)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            const F mi = m[k][I];
+            m[k][I]    = skSimdSelect(swap, m[k][J], mi);
+            m[k][J]    = skSimdSelect(swap, -mi, m[k][J]);
+        }
+    }
+
+    template <int I, int J, typename F>
+    SK_INLINE void sortColumns(F (&b)[3][3], F (&v)[3][3], F (&n)[3])
+    {
+        const auto swap = sortKeys<I, J>(n);
+        swapColumns<I, J>(b, swap);
+        swapColumns<I, J>(v, swap);
+    }
+
+    // One QR Givens step, zeroing b[Q][P].
+    template <int P, int Q, typename F>
+    SK_INLINE void givens(F (&b)[3][3], F (&u)[3][3])
+    {
+        const F eps(SvdTraits<F>::Epsilon);
+
+        const F a1  = b[P][P];
+        const F a2  = b[Q][P];
+        const F rho = skSimdSqrt(a1 * a1 + a2 * a2);
+
+        F sh = skSimdSelect(rho > eps, a2, F(0.f));
+        F ch = skSimdAbs(a1) + skSimdMax(rho, eps);
+
+        const auto neg = a1 < F(0.f);
+        const F    t   = ch;
+
+        ch = skSimdSelect(neg, sh, ch);
+        sh = skSimdSelect(neg, t, sh);
+
+        const F w = skFastMath::rsqrt(ch * ch + sh * sh);
+        ch        = ch * w;
+        sh        = sh * w;
+
+        const F c  = ch * ch - sh * sh;
+        const F sn = F(2.f) * sh * ch;
+
+        rotateRows<P, Q>(b, c, sn);
+        rotateColumns<P, Q>(u, c, sn);
+    }
+
+    template <typename F>
+    SK_INLINE F maxAbs(const F (&a)[3][3])
+    {
+        F r = skSimdAbs(a[0][0]);
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                r = skSimdMax(r, skSimdAbs(a[i][j]));
+        return r;
+    }
+
+    // Accumulates into v the rotations that diagonalize s.
+    template <typename F>
+    SK_INLINE void diagonalize(F (&s)[3][3], F (&v)[3][3])
+    {
+        for (int k = 0; k < SvdTraits<F>::Sweeps; ++k)
+        {
+            jacobi<0, 1>(s, v);
+            jacobi<0, 2>(s, v);
+            jacobi<1, 2>(s, v);
+        }
+    }
+
+    template <typename F>
+    void svdKernel(const F (&a)[3][3], F (&u)[3][3], F (&sv)[3], F (&v)[3][3])
+    {
+        // Work on a / max|a| so that the epsilon is relative. Below the
+        // smallest normal 1 / max|a| overflows, and a is taken as zero.
+        const F scale = maxAbs(a);
+        const F is    = skSimdSelect(scale >= F(SvdTraits<F>::Min), F(1.f) / scale, F(0.f));
+
+        F an[3][3], s[3][3];
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                an[i][j] = a[i][j] * is;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                s[i][j] = an[0][i] * an[0][j] + an[1][i] * an[1][j] + an[2][i] * an[2][j];
+                u[i][j] = v[i][j] = F(i == j ? 1.f : 0.f);
+            }
+        }
+
+        diagonalize(s, v);
+
+        F b[3][3], n[3];
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                b[i][j] = an[i][0] * v[0][j] + an[i][1] * v[1][j] + an[i][2] * v[2][j];
+
+        for (int j = 0; j < 3; ++j)
+            n[j] = b[0][j] * b[0][j] + b[1][j] * b[1][j] + b[2][j] * b[2][j];
+
+        sortColumns<0, 1>(b, v, n);
+        sortColumns<0, 2>(b, v, n);
+        sortColumns<1, 2>(b, v, n);
+
+        givens<0, 1>(b, u);
+        givens<0, 2>(b, u);
+        givens<1, 2>(b, u);
+
+        for (int i = 0; i < 3; ++i)
+            sv[i] = b[i][i] * scale;
+    }
+
+    template <typename F>
+    void eigenKernel(const F (&a)[3][3], F (&v)[3][3], F (&e)[3])
+    {
+        // As in svdKernel, input below the smallest normal is zero.
+        const F scale = maxAbs(a);
+        const F is    = skSimdSelect(scale >= F(SvdTraits<F>::Min), F(1.f) / scale, F(0.f));
+
+        // Only the upper triangle is read.
+        F s[3][3];
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                s[i][j] = (i <= j ? a[i][j] : a[j][i]) * is;
+                v[i][j] = F(i == j ? 1.f : 0.f);
+            }
+        }
+
+        diagonalize(s, v);
+
+        for (int i = 0; i < 3; ++i)
+            e[i] = s[i][i];
+
+        swapColumns<0, 1>(v, sortKeys<0, 1>(e));
+        swapColumns<0, 2>(v, sortKeys<0, 2>(e));
+        swapColumns<1, 2>(v, sortKeys<1, 2>(e));
+
+        for (int i = 0; i < 3; ++i)
+            e[i] = e[i] * scale;
+    }
+
+    template <typename F>
+    void polarFromSvd(F (&r)[3][3], F (&p)[3][3], const F (&u)[3][3], const F (&sv)[3], const F (&v)[3][3])
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                r[i][j] = u[i][0] * v[j][0] + u[i][1] * v[j][1] + u[i][2] * v[j][2];
+                p[i][j] = v[i][0] * sv[0] * v[j][0] + v[i][1] * sv[1] * v[j][1] + v[i][2] * sv[2] * v[j][2];
+            }
+        }
+    }
+
+#ifndef SK_DOUBLE
+    // Transposes four matrices into lanes and back.
+    void loadLanes(skSimd4f (&d)[3][3], const skMatrix3* src)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                const float t[4] = {src[0].m[i][j], src[1].m[i][j], src[2].m[i][j], src[3].m[i][j]};
+                d[i][j]          = skSimd4f::load(t);
+            }
+        }
+    }
+
+    void storeLanes(skMatrix3* dst, const skSimd4f (&d)[3][3])
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                float t[4];
+                d[i][j].store(t);
+                for (int k = 0; k < 4; ++k)
+                    dst[k].m[i][j] = t[k];
+            }
+        }
+    }
+#endif
+}  // namespace
 
 void skMatrix3::print() const
 {
@@ -31,3 +327,117 @@ void skMatrix3::print() const
     printf("[ %3.3f, %3.3f, %3.3f ]\n", (double)m[1][0], (double)m[1][1], (double)m[1][2]);
     printf("[ %3.3f, %3.3f, %3.3f ]\n", (double)m[2][0], (double)m[2][1], (double)m[2][2]);
 }
+
+void skMatrix3::fromAngles(skMatrix3*      dst,
+                           const skScalar* pitch,
+                           const skScalar* yaw,
+                           const skScalar* roll,
+                           SKsize          count)
+{
+    const SKsize Block = 64;
+
+    skScalar s[3][Block], c[3][Block];
+
+    for (SKsize b = 0; b < count; b += Block)
+    {
+        const SKsize n = skMin(Block, count - b);
+
+        skMath::sinCos(pitch + b, s[0], c[0], n);
+        skMath::sinCos(yaw + b, s[1], c[1], n);
+        skMath::sinCos(roll + b, s[2], c[2], n);
+
+        for (SKsize i = 0; i < n; ++i)
+            dst[b + i].fromSinCos(s[0][i], c[0][i], s[1][i], c[1][i], s[2][i], c[2][i]);
+    }
+}
+
+void skMatrix3::svd(skMatrix3& u, skVector3& s, skMatrix3& v) const
+{
+    skScalar sv[3];
+    svdKernel(m, u.m, sv, v.m);
+    s = skVector3(sv[0], sv[1], sv[2]);
+}
+
+void skMatrix3::polar(skMatrix3& r, skMatrix3& s) const
+{
+    skScalar u[3][3], sv[3], v[3][3];
+    svdKernel(m, u, sv, v);
+    polarFromSvd(r.m, s.m, u, sv, v);
+}
+
+void skMatrix3::svd(skMatrix3*       u,
+                    skVector3*       s,
+                    skMatrix3*       v,
+                    const skMatrix3* src,
+                    SKsize           count)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    for (; i + 4 <= count; i += 4)
+    {
+        skSimd4f a[3][3], lu[3][3], ls[3], lv[3][3];
+        loadLanes(a, src + i);
+        svdKernel(a, lu, ls, lv);
+        storeLanes(u + i, lu);
+        storeLanes(v + i, lv);
+
+        float t[3][4];
+        for (int k = 0; k < 3; ++k)
+            ls[k].store(t[k]);
+        for (int k = 0; k < 4; ++k)
+            s[i + k] = skVector3(t[0][k], t[1][k], t[2][k]);
+    }
+#endif
+    for (; i < count; ++i)
+        src[i].svd(u[i], s[i], v[i]);
+}
+
+void skMatrix3::polar(skMatrix3* r, skMatrix3* s, const skMatrix3* src, SKsize count)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    for (; i + 4 <= count; i += 4)
+    {
+        skSimd4f a[3][3], lu[3][3], ls[3], lv[3][3], lr[3][3], lp[3][3];
+        loadLanes(a, src + i);
+        svdKernel(a, lu, ls, lv);
+        polarFromSvd(lr, lp, lu, ls, lv);
+        storeLanes(r + i, lr);
+        storeLanes(s + i, lp);
+    }
+#endif
+    for (; i < count; ++i)
+        src[i].polar(r[i], s[i]);
+}
+
+void skMatrix3::eigenSymmetric(skMatrix3& vectors, skVector3& values) const
+{
+    skScalar e[3];
+    eigenKernel(m, vectors.m, e);
+    values = skVector3(e[0], e[1], e[2]);
+}
+
+void skMatrix3::eigenSymmetric(skMatrix3*       vectors,
+                               skVector3*       values,
+                               const skMatrix3* src,
+                               SKsize           count)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    for (; i + 4 <= count; i += 4)
+    {
+        skSimd4f a[3][3], lv[3][3], le[3];
+        loadLanes(a, src + i);
+        eigenKernel(a, lv, le);
+        storeLanes(vectors + i, lv);
+
+        float t[3][4];
+        for (int k = 0; k < 3; ++k)
+            le[k].store(t[k]);
+        for (int k = 0; k < 4; ++k)
+            values[i + k] = skVector3(t[0][k], t[1][k], t[2][k]);
+    }
+#endif
+    for (; i < count; ++i)
+        src[i].eigenSymmetric(vectors[i], values[i]);
+}
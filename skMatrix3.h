@@ -40,12 +40,12 @@ public:
 public:
     skMatrix3() = default;
 
-    explicit skMatrix3(const skMatrix4& m4)
+    constexpr explicit skMatrix3(const skMatrix4& m4)
     {
         this->fromMat4(m4);
     }
 
-    skMatrix3(skScalar m00,
+    constexpr skMatrix3(skScalar m00,
               skScalar m01,
               skScalar m02,
               skScalar m10,
@@ -66,7 +66,7 @@ public:
         m[2][2] = m22;
     }
 
-    explicit skMatrix3(const skScalar* v)
+    constexpr explicit skMatrix3(const skScalar* v)
     {
         m[0][0] = *v++;
         m[0][1] = *v++;
@@ -79,7 +79,7 @@ public:
         m[2][2] = *v;
     }
 
-    skMatrix3(const skMatrix3& v)
+    constexpr skMatrix3(const skMatrix3& v)
     {
         m[0][0] = v.m[0][0];
         m[0][1] = v.m[0][1];
@@ -92,7 +92,9 @@ public:
         m[2][2] = v.m[2][2];
     }
 
-    skMatrix3 operator*(const skMatrix3& B) const
+    constexpr skMatrix3& operator=(const skMatrix3& v) = default;
+
+    constexpr skMatrix3 operator*(const skMatrix3& B) const
     {
         return skMatrix3(
             m[0][0] * B.m[0][0] + m[0][1] * B.m[1][0] + m[0][2] * B.m[2][0],
@@ -108,38 +110,38 @@ public:
             m[2][0] * B.m[0][2] + m[2][1] * B.m[1][2] + m[2][2] * B.m[2][2]);
     }
 
-    skVector3 operator*(const skVector3& v) const
+    constexpr skVector3 operator*(const skVector3& v) const
     {
         return skVector3(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
                          m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
                          m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
     }
 
-    void transpose()
+    constexpr void transpose()
     {
         *this = transposed();
     }
 
-    skMatrix3 transposed() const
+    constexpr skMatrix3 transposed() const
     {
         return skMatrix3(m[0][0], m[1][0], m[2][0], m[0][1], m[1][1], m[2][1], m[0][2], m[1][2], m[2][2]);
     }
 
-    skVector3 row(const int idx) const
+    constexpr skVector3 row(const int idx) const
     {
         if (idx < 3 && idx >= 0)
             return skVector3(m[0][idx], m[1][idx], m[2][idx]);
         return skVector3::Zero;
     }
 
-    skVector3 col(const int idx) const
+    constexpr skVector3 col(const int idx) const
     {
         if (idx < 3 && idx >= 0)
             return skVector3(m[idx][0], m[idx][1], m[idx][2]);
         return skVector3::Zero;
     }
 
-    void makeIdentity()
+    constexpr void makeIdentity()
     {
         m[0][0] = 1;
         m[0][1] = 0;
@@ -158,7 +160,30 @@ public:
         skMath::sinCos(pitch, s0, c0);
         skMath::sinCos(yaw, s1, c1);
         skMath::sinCos(roll, s2, c2);
+        fromSinCos(s0, c0, s1, c1, s2, c2);
+    }
 
+    /// <summary>
+    /// Bulk form of fromAngles for count sets of angles in radians.
+    /// The sines and cosines are computed in blocks with skMath::sinCos.
+    /// </summary>
+    static void fromAngles(skMatrix3*      dst,
+                           const skScalar* pitch,
+                           const skScalar* yaw,
+                           const skScalar* roll,
+                           SKsize          count);
+
+    /// <summary>
+    /// Builds the fromAngles rotation from the sine and cosine of
+    /// pitch (0), yaw (1) and roll (2).
+    /// </summary>
+    constexpr void fromSinCos(const skScalar s0,
+                              const skScalar c0,
+                              const skScalar s1,
+                              const skScalar c1,
+                              const skScalar s2,
+                              const skScalar c2)
+    {
         const skScalar s2c0 = s2 * c0;
         const skScalar s2s0 = s2 * s0;
 
@@ -178,7 +203,7 @@ public:
         fromAngles(e.pitch, e.yaw, e.roll);
     }
 
-    void fromQuat(const skQuaternion& q)
+    constexpr void fromQuat(const skQuaternion& q)
     {
         const skScalar qx2 = q.x * q.x;
         const skScalar qy2 = q.y * q.y;
@@ -205,7 +230,7 @@ public:
         m[2][2] = skScalar(1.0) - skScalar(2.0) * (qx2 + qy2);
     }
 
-    void fromMat4(const skMatrix4& m4x4)
+    constexpr void fromMat4(const skMatrix4& m4x4)
     {
         m[0][0] = m4x4.m[0][0];
         m[0][1] = m4x4.m[0][1];
@@ -220,6 +245,50 @@ public:
         m[2][2] = m4x4.m[2][2];
     }
 
+    /// <summary>
+    /// Singular value decomposition, this = u * diag(s) * v^T, with u and
+    /// v rotations. The values are ordered by decreasing magnitude and
+    /// s.z carries the sign of the determinant.
+    /// </summary>
+    void svd(skMatrix3& u, skVector3& s, skMatrix3& v) const;
+
+    /// <summary>
+    /// Polar decomposition, this = r * s, with r a rotation and s
+    /// symmetric.
+    /// </summary>
+    void polar(skMatrix3& r, skMatrix3& s) const;
+
+    /// <summary>
+    /// Batch form of svd. Single precision runs four matrices at a
+    /// time, one per skSimd4f lane.
+    /// </summary>
+    static void svd(skMatrix3*       u,
+                    skVector3*       s,
+                    skMatrix3*       v,
+                    const skMatrix3* src,
+                    SKsize           count);
+
+    /// <summary>
+    /// Batch form of polar.
+    /// </summary>
+    static void polar(skMatrix3* r, skMatrix3* s, const skMatrix3* src, SKsize count);
+
+    /// <summary>
+    /// Eigen decomposition of a symmetric matrix, this = vectors *
+    /// diag(values) * vectors^T. Only the upper triangle is read. The
+    /// values are sorted in decreasing order, vectors holds the matching
+    /// unit eigenvectors in its columns and is a rotation.
+    /// </summary>
+    void eigenSymmetric(skMatrix3& vectors, skVector3& values) const;
+
+    /// <summary>
+    /// Batch form of eigenSymmetric.
+    /// </summary>
+    static void eigenSymmetric(skMatrix3*       vectors,
+                               skVector3*       values,
+                               const skMatrix3* src,
+                               SKsize           count);
+
     void print() const;
 
 public:
@@ -227,4 +296,7 @@ public:
     static const skMatrix3 Zero;
 };
 
+inline constexpr skMatrix3 skMatrix3::Identity = skMatrix3(1, 0, 0, 0, 1, 0, 0, 0, 1);
+inline constexpr skMatrix3 skMatrix3::Zero     = skMatrix3(0, 0, 0, 0, 0, 0, 0, 0, 0);
+
 #endif  //_skMatrix3_h_
@@ -25,69 +25,207 @@
 #include "skVector3.h"
 #include "skTransform2D.h"
 
-class skMatrix4
+/// <summary>
+/// Row major 4x4 matrix with the precision given by T.
+/// skMatrix4 is the skScalar instance, skMatrix4f and skMatrix4d are the
+/// fixed precision instances.
+/// </summary>
+template <typename T>
+class skMatrix4T
 {
+public:
+    typedef T            ValueType;
+    typedef skScalarT<T> Traits;
+
 public:
     union
     {
-        skScalar m[4][4];
-        skScalar p[16]{};
+        T m[4][4]{};
+        T p[16];
     };
 
 public:
-    skMatrix4()
+    constexpr skMatrix4T()
+    {
+    }
+
+    constexpr skMatrix4T(const skMatrix4T& v) = default;
+
+    constexpr skMatrix4T(T m00,
+                        T m01,
+                        T m02,
+                        T m03,
+                        T m10,
+                        T m11,
+                        T m12,
+                        T m13,
+                        T m20,
+                        T m21,
+                        T m22,
+                        T m23,
+                        T m30,
+                        T m31,
+                        T m32,
+                        T m33)
+    {
+        m[0][0] = m00;
+        m[0][1] = m01;
+        m[0][2] = m02;
+        m[0][3] = m03;
+        m[1][0] = m10;
+        m[1][1] = m11;
+        m[1][2] = m12;
+        m[1][3] = m13;
+        m[2][0] = m20;
+        m[2][1] = m21;
+        m[2][2] = m22;
+        m[2][3] = m23;
+        m[3][0] = m30;
+        m[3][1] = m31;
+        m[3][2] = m32;
+        m[3][3] = m33;
+    }
+
+    /// <summary>
+    /// Converts from a matrix of a different precision.
+    /// </summary>
+    template <typename U>
+    constexpr explicit skMatrix4T(const skMatrix4T<U>& v)
     {
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                m[i][j] = T(v.m[i][j]);
     }
 
-    skMatrix4(const skMatrix4& v);
-    skMatrix4(skScalar m00,
-              skScalar m01,
-              skScalar m02,
-              skScalar m03,
-              skScalar m10,
-              skScalar m11,
-              skScalar m12,
-              skScalar m13,
-              skScalar m20,
-              skScalar m21,
-              skScalar m22,
-              skScalar m23,
-              skScalar m30,
-              skScalar m31,
-              skScalar m32,
-              skScalar m33);
-
-    skMatrix4(const skTransform2D& v);
-    skMatrix4(const skScalar* v);
-
-    skMatrix4& operator=(const skMatrix4& v);
-    skMatrix4  operator*(const skMatrix4& v) const;
-    skMatrix4& transpose();
-    skMatrix4  transposed() const;
-
-    void      setTrans(const skVector3& v);
-    void      setTrans(skScalar x, skScalar y, skScalar z);
-    void      setScale(const skVector3& v);
-    void      setScale(skScalar x, skScalar y, skScalar z);
-    skVector3 getScale() const;
-    skVector3 getTrans() const;
+    skMatrix4T(const skTransform2D& v);
+    skMatrix4T(const T* v);
+
+    constexpr skMatrix4T& operator=(const skMatrix4T& v) = default;
+
+    constexpr skMatrix4T operator*(const skMatrix4T& v) const;
+    skMatrix4T&          transpose();
+    constexpr skMatrix4T transposed() const;
+
+    void      setTrans(const skVector3T<T>& v);
+    void      setTrans(T x, T y, T z);
+    void      setScale(const skVector3T<T>& v);
+    void      setScale(T x, T y, T z);
+    skVector3T<T> getScale() const;
+    skVector3T<T> getTrans() const;
     void      makeIdentity();
-    skScalar  det() const;
-    skMatrix4 inverted() const;
+    constexpr T det() const;
+    constexpr skMatrix4T inverted() const;
 
-    void multAssign(const skMatrix4& a, const skMatrix4& b);
+    void multAssign(const skMatrix4T& a, const skMatrix4T& b);
 
-    void        makeTransform(const skVector3& loc, const skVector3& scale, const skQuaternion& rot);
-    void        makeTransform(const skVector3& loc, const skVector3& scale, const skMatrix3& rot);
-    void        makeInverseTransform(const skVector3& loc, const skVector3& scale, const skQuaternion& rot);
-    void        makeInverseTransform(const skVector3& loc, const skVector3& scale, const skMatrix3& rot);
-    static void merge(skMatrix4& d, const skMatrix4& a, const skMatrix4& b);
+    void        makeTransform(const skVector3T<T>& loc, const skVector3T<T>& scale, const skQuaternion& rot);
+    void        makeTransform(const skVector3T<T>& loc, const skVector3T<T>& scale, const skMatrix3& rot);
+    void        makeInverseTransform(const skVector3T<T>& loc, const skVector3T<T>& scale, const skQuaternion& rot);
+    void        makeInverseTransform(const skVector3T<T>& loc, const skVector3T<T>& scale, const skMatrix3& rot);
+    static void merge(skMatrix4T& d, const skMatrix4T& a, const skMatrix4T& b);
 
     void print() const;
 
 public:
-    static const skMatrix4 Identity;
-    static const skMatrix4 Zero;
+    static const skMatrix4T Identity;
+    static const skMatrix4T Zero;
 };
 
+template <typename T>
+inline constexpr skMatrix4T<T> skMatrix4T<T>::Identity = skMatrix4T<T>(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
+template <typename T>
+inline constexpr skMatrix4T<T> skMatrix4T<T>::Zero = skMatrix4T<T>(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+// The products, transpose and inverse are constexpr so that tables of
+// transforms can be built at compile time, and so live in the header.
+template <typename T>
+constexpr skMatrix4T<T> skMatrix4T<T>::operator*(const skMatrix4T<T>& v) const
+{
+    return skMatrix4T<T>(
+        m[0][0] * v.m[0][0] + m[0][1] * v.m[1][0] + m[0][2] * v.m[2][0] + m[0][3] * v.m[3][0],
+        m[0][0] * v.m[0][1] + m[0][1] * v.m[1][1] + m[0][2] * v.m[2][1] + m[0][3] * v.m[3][1],
+        m[0][0] * v.m[0][2] + m[0][1] * v.m[1][2] + m[0][2] * v.m[2][2] + m[0][3] * v.m[3][2],
+        m[0][0] * v.m[0][3] + m[0][1] * v.m[1][3] + m[0][2] * v.m[2][3] + m[0][3] * v.m[3][3],
+
+        m[1][0] * v.m[0][0] + m[1][1] * v.m[1][0] + m[1][2] * v.m[2][0] + m[1][3] * v.m[3][0],
+        m[1][0] * v.m[0][1] + m[1][1] * v.m[1][1] + m[1][2] * v.m[2][1] + m[1][3] * v.m[3][1],
+        m[1][0] * v.m[0][2] + m[1][1] * v.m[1][2] + m[1][2] * v.m[2][2] + m[1][3] * v.m[3][2],
+        m[1][0] * v.m[0][3] + m[1][1] * v.m[1][3] + m[1][2] * v.m[2][3] + m[1][3] * v.m[3][3],
+
+        m[2][0] * v.m[0][0] + m[2][1] * v.m[1][0] + m[2][2] * v.m[2][0] + m[2][3] * v.m[3][0],
+        m[2][0] * v.m[0][1] + m[2][1] * v.m[1][1] + m[2][2] * v.m[2][1] + m[2][3] * v.m[3][1],
+        m[2][0] * v.m[0][2] + m[2][1] * v.m[1][2] + m[2][2] * v.m[2][2] + m[2][3] * v.m[3][2],
+        m[2][0] * v.m[0][3] + m[2][1] * v.m[1][3] + m[2][2] * v.m[2][3] + m[2][3] * v.m[3][3],
+
+        m[3][0] * v.m[0][0] + m[3][1] * v.m[1][0] + m[3][2] * v.m[2][0] + m[3][3] * v.m[3][0],
+        m[3][0] * v.m[0][1] + m[3][1] * v.m[1][1] + m[3][2] * v.m[2][1] + m[3][3] * v.m[3][1],
+        m[3][0] * v.m[0][2] + m[3][1] * v.m[1][2] + m[3][2] * v.m[2][2] + m[3][3] * v.m[3][2],
+        m[3][0] * v.m[0][3] + m[3][1] * v.m[1][3] + m[3][2] * v.m[2][3] + m[3][3] * v.m[3][3]);
+}
+
+template <typename T>
+constexpr skMatrix4T<T> skMatrix4T<T>::transposed() const
+{
+    return skMatrix4T<T>(m[0][0], m[1][0], m[2][0], m[3][0], m[0][1], m[1][1], m[2][1], m[3][1], m[0][2], m[1][2], m[2][2], m[3][2], m[0][3], m[1][3], m[2][3], m[3][3]);
+}
+
+template <typename T>
+constexpr T skMatrix4T<T>::det() const
+{
+    return m[0][3] * m[1][2] * m[2][1] * m[3][0] - m[0][2] * m[1][3] * m[2][1] * m[3][0] - m[0][3] * m[1][1] * m[2][2] * m[3][0] + m[0][1] * m[1][3] * m[2][2] * m[3][0] +
+           m[0][2] * m[1][1] * m[2][3] * m[3][0] - m[0][1] * m[1][2] * m[2][3] * m[3][0] - m[0][3] * m[1][2] * m[2][0] * m[3][1] + m[0][2] * m[1][3] * m[2][0] * m[3][1] +
+           m[0][3] * m[1][0] * m[2][2] * m[3][1] - m[0][0] * m[1][3] * m[2][2] * m[3][1] - m[0][2] * m[1][0] * m[2][3] * m[3][1] + m[0][0] * m[1][2] * m[2][3] * m[3][1] +
+           m[0][3] * m[1][1] * m[2][0] * m[3][2] - m[0][1] * m[1][3] * m[2][0] * m[3][2] - m[0][3] * m[1][0] * m[2][1] * m[3][2] + m[0][0] * m[1][3] * m[2][1] * m[3][2] +
+           m[0][1] * m[1][0] * m[2][3] * m[3][2] - m[0][0] * m[1][1] * m[2][3] * m[3][2] - m[0][2] * m[1][1] * m[2][0] * m[3][3] + m[0][1] * m[1][2] * m[2][0] * m[3][3] +
+           m[0][2] * m[1][0] * m[2][1] * m[3][3] - m[0][0] * m[1][2] * m[2][1] * m[3][3] - m[0][1] * m[1][0] * m[2][2] * m[3][3] + m[0][0] * m[1][1] * m[2][2] * m[3][3];
+}
+
+template <typename T>
+constexpr skMatrix4T<T> skMatrix4T<T>::inverted() const
+{
+    skMatrix4T<T> r;
+
+    T d = det();
+    if (Traits::isZero(d))
+        return Identity;
+
+    d = T(1.0) / d;
+
+    r.m[0][0] = d * (m[1][2] * m[2][3] * m[3][1] - m[1][3] * m[2][2] * m[3][1] + m[1][3] * m[2][1] * m[3][2] - m[1][1] * m[2][3] * m[3][2] - m[1][2] * m[2][1] * m[3][3] + m[1][1] * m[2][2] * m[3][3]);
+    r.m[1][0] = d * (m[0][3] * m[2][2] * m[3][1] - m[0][2] * m[2][3] * m[3][1] - m[0][3] * m[2][1] * m[3][2] + m[0][1] * m[2][3] * m[3][2] + m[0][2] * m[2][1] * m[3][3] - m[0][1] * m[2][2] * m[3][3]);
+    r.m[2][0] = d * (m[0][2] * m[1][3] * m[3][1] - m[0][3] * m[1][2] * m[3][1] + m[0][3] * m[1][1] * m[3][2] - m[0][1] * m[1][3] * m[3][2] - m[0][2] * m[1][1] * m[3][3] + m[0][1] * m[1][2] * m[3][3]);
+    r.m[3][0] = d * (m[0][3] * m[1][2] * m[2][1] - m[0][2] * m[1][3] * m[2][1] - m[0][3] * m[1][1] * m[2][2] + m[0][1] * m[1][3] * m[2][2] + m[0][2] * m[1][1] * m[2][3] - m[0][1] * m[1][2] * m[2][3]);
+    r.m[0][1] = d * (m[1][3] * m[2][2] * m[3][0] - m[1][2] * m[2][3] * m[3][0] - m[1][3] * m[2][0] * m[3][2] + m[1][0] * m[2][3] * m[3][2] + m[1][2] * m[2][0] * m[3][3] - m[1][0] * m[2][2] * m[3][3]);
+    r.m[1][1] = d * (m[0][2] * m[2][3] * m[3][0] - m[0][3] * m[2][2] * m[3][0] + m[0][3] * m[2][0] * m[3][2] - m[0][0] * m[2][3] * m[3][2] - m[0][2] * m[2][0] * m[3][3] + m[0][0] * m[2][2] * m[3][3]);
+    r.m[2][1] = d * (m[0][3] * m[1][2] * m[3][0] - m[0][2] * m[1][3] * m[3][0] - m[0][3] * m[1][0] * m[3][2] + m[0][0] * m[1][3] * m[3][2] + m[0][2] * m[1][0] * m[3][3] - m[0][0] * m[1][2] * m[3][3]);
+    r.m[3][1] = d * (m[0][2] * m[1][3] * m[2][0] - m[0][3] * m[1][2] * m[2][0] + m[0][3] * m[1][0] * m[2][2] - m[0][0] * m[1][3] * m[2][2] - m[0][2] * m[1][0] * m[2][3] + m[0][0] * m[1][2] * m[2][3]);
+    r.m[0][2] = d * (m[1][1] * m[2][3] * m[3][0] - m[1][3] * m[2][1] * m[3][0] + m[1][3] * m[2][0] * m[3][1] - m[1][0] * m[2][3] * m[3][1] - m[1][1] * m[2][0] * m[3][3] + m[1][0] * m[2][1] * m[3][3]);
+    r.m[1][2] = d * (m[0][3] * m[2][1] * m[3][0] - m[0][1] * m[2][3] * m[3][0] - m[0][3] * m[2][0] * m[3][1] + m[0][0] * m[2][3] * m[3][1] + m[0][1] * m[2][0] * m[3][3] - m[0][0] * m[2][1] * m[3][3]);
+    r.m[2][2] = d * (m[0][1] * m[1][3] * m[3][0] - m[0][3] * m[1][1] * m[3][0] + m[0][3] * m[1][0] * m[3][1] - m[0][0] * m[1][3] * m[3][1] - m[0][1] * m[1][0] * m[3][3] + m[0][0] * m[1][1] * m[3][3]);
+    r.m[3][2] = d * (m[0][3] * m[1][1] * m[2][0] - m[0][1] * m[1][3] * m[2][0] - m[0][3] * m[1][0] * m[2][1] + m[0][0] * m[1][3] * m[2][1] + m[0][1] * m[1][0] * m[2][3] - m[0][0] * m[1][1] * m[2][3]);
+    r.m[0][3] = d * (m[1][2] * m[2][1] * m[3][0] - m[1][1] * m[2][2] * m[3][0] - m[1][2] * m[2][0] * m[3][1] + m[1][0] * m[2][2] * m[3][1] + m[1][1] * m[2][0] * m[3][2] - m[1][0] * m[2][1] * m[3][2]);
+    r.m[1][3] = d * (m[0][1] * m[2][2] * m[3][0] - m[0][2] * m[2][1] * m[3][0] + m[0][2] * m[2][0] * m[3][1] - m[0][0] * m[2][2] * m[3][1] - m[0][1] * m[2][0] * m[3][2] + m[0][0] * m[2][1] * m[3][2]);
+    r.m[2][3] = d * (m[0][2] * m[1][1] * m[3][0] - m[0][1] * m[1][2] * m[3][0] - m[0][2] * m[1][0] * m[3][1] + m[0][0] * m[1][2] * m[3][1] + m[0][1] * m[1][0] * m[3][2] - m[0][0] * m[1][1] * m[3][2]);
+    r.m[3][3] = d * (m[0][1] * m[1][2] * m[2][0] - m[0][2] * m[1][1] * m[2][0] + m[0][2] * m[1][0] * m[2][1] - m[0][0] * m[1][2] * m[2][1] - m[0][1] * m[1][0] * m[2][2] + m[0][0] * m[1][1] * m[2][2]);
+
+    return r;
+}
+
+// The float and double instances are compiled into the library. In
+// header only mode they are instantiated by the caller instead.
+#ifndef SK_MATH_HEADER_ONLY
+extern template class skMatrix4T<float>;
+extern template class skMatrix4T<double>;
+#endif
+
+/// <summary>
+/// skMatrix4 aligned to a cache line. A single precision matrix fills
+/// the line, and its rows are aligned SIMD loads.
+/// </summary>
+typedef skAligned<skMatrix4, skCacheLine> skMatrix4A;
+
+#ifdef SK_MATH_HEADER_ONLY
+#include "skMatrix4.inl"
+#endif
+
 #endif  //_skMatrix4_h_
@@ -0,0 +1,245 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skOrientation.h"
+
+namespace
+{
+    const SKsize Block = 64;
+
+    enum Element
+    {
+        M00,
+        M02,
+        M10,
+        M11,
+        M12,
+        M20,
+        M22,
+        MaxElement,
+    };
+
+    // Euler angles from the matrix elements that fromAngles defines:
+    //   m10 =  sin(roll)
+    //   m00 =  cos(yaw) cos(roll),   m20 = -sin(yaw) cos(roll)
+    //   m11 =  cos(roll) cos(pitch), m12 = -cos(roll) sin(pitch)
+    void anglesFromElements(skScalar* pitch,
+                            skScalar* yaw,
+                            skScalar* roll,
+                            skScalar  e[MaxElement][Block],
+                            SKsize    n)
+    {
+        skScalar cr[Block], ny[Block], np[Block];
+
+        for (SKsize i = 0; i < n; ++i)
+        {
+            cr[i] = skSqrt(e[M00][i] * e[M00][i] + e[M20][i] * e[M20][i]);
+            ny[i] = -e[M20][i];
+            np[i] = -e[M12][i];
+        }
+
+        skMath::atan2(roll, e[M10], cr, n);
+        skMath::atan2(yaw, ny, e[M00], n);
+        skMath::atan2(pitch, np, e[M11], n);
+
+        for (SKsize i = 0; i < n; ++i)
+        {
+            if (cr[i] < skScalar(16) * SK_EPSILON)
+            {
+                // cos(roll) = 0, only yaw + pitch or yaw - pitch is defined.
+                pitch[i] = 0;
+                skMath::atan2(yaw + i, &e[M02][i], &e[M22][i], 1);
+            }
+        }
+    }
+}  // namespace
+
+void skOrientationUtils::convert(skQuaternion*   dst,
+                                 const skScalar* pitch,
+                                 const skScalar* yaw,
+                                 const skScalar* roll,
+                                 SKsize          count)
+{
+    skScalar h[3][Block], s[3][Block], c[3][Block];
+
+    for (SKsize b = 0; b < count; b += Block)
+    {
+        const SKsize n = skMin(Block, count - b);
+
+        for (SKsize i = 0; i < n; ++i)
+        {
+            h[0][i] = pitch[b + i] * skScalar(0.5);
+            h[1][i] = yaw[b + i] * skScalar(0.5);
+            h[2][i] = roll[b + i] * skScalar(0.5);
+        }
+
+        skMath::sinCos(h[0], s[0], c[0], n);
+        skMath::sinCos(h[1], s[1], c[1], n);
+        skMath::sinCos(h[2], s[2], c[2], n);
+
+        // qy(yaw) qz(roll) qx(pitch) expanded.
+        for (SKsize i = 0; i < n; ++i)
+        {
+            const skScalar sx = s[0][i], cx = c[0][i];
+            const skScalar sy = s[1][i], cy = c[1][i];
+            const skScalar sz = s[2][i], cz = c[2][i];
+
+            skQuaternion& q = dst[b + i];
+
+            q.w = cy * cz * cx - sy * sz * sx;
+            q.x = cy * cz * sx + sy * sz * cx;
+            q.y = sy * cz * cx + cy * sz * sx;
+            q.z = cy * sz * cx - sy * cz * sx;
+        }
+    }
+}
+
+void skOrientationUtils::convert(skMatrix3*      dst,
+                                 const skScalar* pitch,
+                                 const skScalar* yaw,
+                                 const skScalar* roll,
+                                 SKsize          count)
+{
+    skMatrix3::fromAngles(dst, pitch, yaw, roll, count);
+}
+
+void skOrientationUtils::convert(skMatrix3* dst, const skQuaternion* src, SKsize count)
+{
+    for (SKsize i = 0; i < count; ++i)
+        dst[i].fromQuat(src[i]);
+}
+
+void skOrientationUtils::convert(skQuaternion* dst, const skMatrix3* src, SKsize count)
+{
+    // Shepperd's method, pivoting on the largest of w, x, y and z
+    // so that the square root never sees a cancelled difference.
+    for (SKsize i = 0; i < count; ++i)
+    {
+        const skScalar(&m)[3][3] = src[i].m;
+
+        skQuaternion& q = dst[i];
+
+        const skScalar tr = m[0][0] + m[1][1] + m[2][2];
+
+        if (tr >= m[0][0] && tr >= m[1][1] && tr >= m[2][2])
+        {
+            const skScalar r = skSqrt(skScalar(1) + tr);
+            const skScalar f = skScalar(0.5) / r;
+
+            q.w = skScalar(0.5) * r;
+            q.x = (m[2][1] - m[1][2]) * f;
+            q.y = (m[0][2] - m[2][0]) * f;
+            q.z = (m[1][0] - m[0][1]) * f;
+        }
+        else if (m[0][0] >= m[1][1] && m[0][0] >= m[2][2])
+        {
+            const skScalar r = skSqrt(skScalar(1) + m[0][0] - m[1][1] - m[2][2]);
+            const skScalar f = skScalar(0.5) / r;
+
+            q.w = (m[2][1] - m[1][2]) * f;
+            q.x = skScalar(0.5) * r;
+            q.y = (m[0][1] + m[1][0]) * f;
+            q.z = (m[0][2] + m[2][0]) * f;
+        }
+        else if (m[1][1] >= m[2][2])
+        {
+            const skScalar r = skSqrt(skScalar(1) - m[0][0] + m[1][1] - m[2][2]);
+            const skScalar f = skScalar(0.5) / r;
+
+            q.w = (m[0][2] - m[2][0]) * f;
+            q.x = (m[0][1] + m[1][0]) * f;
+            q.y = skScalar(0.5) * r;
+            q.z = (m[1][2] + m[2][1]) * f;
+        }
+        else
+        {
+            const skScalar r = skSqrt(skScalar(1) - m[0][0] - m[1][1] + m[2][2]);
+            const skScalar f = skScalar(0.5) / r;
+
+            q.w = (m[1][0] - m[0][1]) * f;
+            q.x = (m[0][2] + m[2][0]) * f;
+            q.y = (m[1][2] + m[2][1]) * f;
+            q.z = skScalar(0.5) * r;
+        }
+
+        if (q.w < 0)
+            q = skQuaternion(-q.w, -q.x, -q.y, -q.z);
+    }
+}
+
+void skOrientationUtils::convert(skScalar*        pitch,
+                                 skScalar*        yaw,
+                                 skScalar*        roll,
+                                 const skMatrix3* src,
+                                 SKsize           count)
+{
+    skScalar e[MaxElement][Block];
+
+    for (SKsize b = 0; b < count; b += Block)
+    {
+        const SKsize n = skMin(Block, count - b);
+
+        for (SKsize i = 0; i < n; ++i)
+        {
+            const skScalar(&m)[3][3] = src[b + i].m;
+
+            e[M00][i] = m[0][0];
+            e[M02][i] = m[0][2];
+            e[M10][i] = m[1][0];
+            e[M11][i] = m[1][1];
+            e[M12][i] = m[1][2];
+            e[M20][i] = m[2][0];
+            e[M22][i] = m[2][2];
+        }
+
+        anglesFromElements(pitch + b, yaw + b, roll + b, e, n);
+    }
+}
+
+void skOrientationUtils::convert(skScalar*           pitch,
+                                 skScalar*           yaw,
+                                 skScalar*           roll,
+                                 const skQuaternion* src,
+                                 SKsize              count)
+{
+    skScalar e[MaxElement][Block];
+
+    for (SKsize b = 0; b < count; b += Block)
+    {
+        const SKsize n = skMin(Block, count - b);
+
+        // Only the matrix elements that the angles need, as in fromQuat.
+        for (SKsize i = 0; i < n; ++i)
+        {
+            const skQuaternion& q = src[b + i];
+
+            e[M00][i] = skScalar(1) - skScalar(2) * (q.y * q.y + q.z * q.z);
+            e[M02][i] = skScalar(2) * (q.x * q.z + q.w * q.y);
+            e[M10][i] = skScalar(2) * (q.x * q.y + q.w * q.z);
+            e[M11][i] = skScalar(1) - skScalar(2) * (q.x * q.x + q.z * q.z);
+            e[M12][i] = skScalar(2) * (q.y * q.z - q.w * q.x);
+            e[M20][i] = skScalar(2) * (q.x * q.z - q.w * q.y);
+            e[M22][i] = skScalar(1) - skScalar(2) * (q.x * q.x + q.y * q.y);
+        }
+
+        anglesFromElements(pitch + b, yaw + b, roll + b, e, n);
+    }
+}
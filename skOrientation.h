@@ -0,0 +1,77 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skOrientation_h_
+#define _skOrientation_h_
+
+#include "skMatrix3.h"
+#include "skQuaternion.h"
+
+/// <summary>
+/// Batch conversions between Euler angles, quaternions and rotation
+/// matrices. Euler angles are passed as separate pitch, yaw and roll
+/// arrays in radians and follow skMatrix3::fromAngles, that is
+/// R = Ry(yaw) Rz(roll) Rx(pitch).
+///
+/// Every conversion uses a closed form and works through the arrays in
+/// blocks, so the sines, cosines and arc tangents of a block go through
+/// the array forms in skMath.
+/// </summary>
+class skOrientationUtils
+{
+public:
+    static void convert(skQuaternion*   dst,
+                        const skScalar* pitch,
+                        const skScalar* yaw,
+                        const skScalar* roll,
+                        SKsize          count);
+
+    static void convert(skMatrix3*      dst,
+                        const skScalar* pitch,
+                        const skScalar* yaw,
+                        const skScalar* roll,
+                        SKsize          count);
+
+    static void convert(skMatrix3* dst, const skQuaternion* src, SKsize count);
+
+    /// <summary>
+    /// Expects proper rotations. The result has w >= 0.
+    /// </summary>
+    static void convert(skQuaternion* dst, const skMatrix3* src, SKsize count);
+
+    /// <summary>
+    /// Returns roll in [-pi/2, pi/2]. At roll = +-pi/2 pitch is set to
+    /// zero and the remaining rotation goes into yaw.
+    /// </summary>
+    static void convert(skScalar*        pitch,
+                        skScalar*        yaw,
+                        skScalar*        roll,
+                        const skMatrix3* src,
+                        SKsize           count);
+
+    static void convert(skScalar*           pitch,
+                        skScalar*           yaw,
+                        skScalar*           roll,
+                        const skQuaternion* src,
+                        SKsize              count);
+};
+
+#endif  //_skOrientation_h_
@@ -0,0 +1,171 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skOrientedBox2D.h"
+#include <cstdio>
+
+namespace
+{
+    // A box spread over lanes.
+    template <typename F>
+    struct BoxLanes
+    {
+        F c[2];
+        F a[2];
+        F e[2];
+    };
+
+    template <typename F>
+    void broadcast(BoxLanes<F>& d, const skOrientedBox2D& box)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            d.c[i] = F(box.center.ptr()[i]);
+            d.a[i] = F(box.axis.ptr()[i]);
+            d.e[i] = F(box.extent.ptr()[i]);
+        }
+    }
+
+#ifndef SK_DOUBLE
+    void loadLanes(BoxLanes<skSimd4f>& d, const skOrientedBox2D* box)
+    {
+        float t[6][4];
+        for (int l = 0; l < 4; ++l)
+        {
+            for (int i = 0; i < 2; ++i)
+            {
+                t[i][l]     = box[l].center.ptr()[i];
+                t[2 + i][l] = box[l].axis.ptr()[i];
+                t[4 + i][l] = box[l].extent.ptr()[i];
+            }
+        }
+
+        for (int i = 0; i < 2; ++i)
+        {
+            d.c[i] = skSimd4f::load(t[i]);
+            d.a[i] = skSimd4f::load(t[2 + i]);
+            d.e[i] = skSimd4f::load(t[4 + i]);
+        }
+    }
+#endif
+
+    // Returns the largest gap between the projections of A and B over
+    // the four edge normals. The boxes overlap when it is not positive.
+    template <typename F>
+    F separation(const BoxLanes<F>& A, const BoxLanes<F>& B)
+    {
+        // Axes of A as u0 = a, u1 = perp(a), likewise for B.
+        const F u[2][2] = {{A.a[0], A.a[1]}, {-A.a[1], A.a[0]}};
+        const F v[2][2] = {{B.a[0], B.a[1]}, {-B.a[1], B.a[0]}};
+
+        const F d[2] = {B.c[0] - A.c[0], B.c[1] - A.c[1]};
+
+        F t[2], r[2][2], ar[2][2];
+        for (int i = 0; i < 2; ++i)
+        {
+            t[i] = d[0] * u[i][0] + d[1] * u[i][1];
+            for (int j = 0; j < 2; ++j)
+            {
+                r[i][j]  = u[i][0] * v[j][0] + u[i][1] * v[j][1];
+                ar[i][j] = skSimdAbs(r[i][j]);
+            }
+        }
+
+        F gap = skSimdAbs(t[0]) - (A.e[0] + B.e[0] * ar[0][0] + B.e[1] * ar[0][1]);
+        gap   = skSimdMax(gap, skSimdAbs(t[1]) - (A.e[1] + B.e[0] * ar[1][0] + B.e[1] * ar[1][1]));
+
+        for (int j = 0; j < 2; ++j)
+        {
+            const F tp = t[0] * r[0][j] + t[1] * r[1][j];
+            gap        = skSimdMax(gap, skSimdAbs(tp) - (A.e[0] * ar[0][j] + A.e[1] * ar[1][j] + B.e[j]));
+        }
+        return gap;
+    }
+}  // namespace
+
+bool skOrientedBox2D::contains(const skVector2& point) const
+{
+    const skVector2 d = point - center;
+    return skAbs(axis.dot(d)) <= extent.x && skAbs(perpendicular().dot(d)) <= extent.y;
+}
+
+bool skOrientedBox2D::overlaps(const skOrientedBox2D& box) const
+{
+    BoxLanes<skScalar> a, b;
+    broadcast(a, *this);
+    broadcast(b, box);
+    return separation(a, b) <= 0;
+}
+
+skBoundingBox2D skOrientedBox2D::getBounds() const
+{
+    const skScalar hx = skAbs(axis.x) * extent.x + skAbs(axis.y) * extent.y;
+    const skScalar hy = skAbs(axis.y) * extent.x + skAbs(axis.x) * extent.y;
+    return skBoundingBox2D(center.x - hx, center.y - hy, center.x + hx, center.y + hy);
+}
+
+SKsize skOrientedBox2D::overlaps(SKuint32*              hits,
+                                 const skOrientedBox2D& box,
+                                 const skOrientedBox2D* boxes,
+                                 SKsize                 count)
+{
+    SKsize n = 0, i = 0;
+
+#ifndef SK_DOUBLE
+    BoxLanes<skSimd4f> a, b;
+    broadcast(a, box);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        loadLanes(b, boxes + i);
+
+        const skSimd4f gap = separation(a, b);
+        if (!skSimdAny(gap <= skSimd4f(0.f)))
+            continue;
+
+        float g[4];
+        gap.store(g);
+        for (SKuint32 l = 0; l < 4; ++l)
+        {
+            if (g[l] <= 0)
+                hits[n++] = (SKuint32)(i + l);
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (box.overlaps(boxes[i]))
+            hits[n++] = (SKuint32)i;
+    }
+    return n;
+}
+
+void skOrientedBox2D::print() const
+{
+    printf("C[%3.3f, %3.3f] A[%3.3f, %3.3f] E[%3.3f, %3.3f]\n",
+           (double)center.x,
+           (double)center.y,
+           (double)axis.x,
+           (double)axis.y,
+           (double)extent.x,
+           (double)extent.y);
+}
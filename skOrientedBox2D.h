@@ -0,0 +1,90 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skOrientedBox2D_h_
+#define _skOrientedBox2D_h_
+
+#include "Math/skBoundingBox2D.h"
+#include "Math/skVector2.h"
+
+/// <summary>
+/// A rectangle with center c and half extents e along the unit axis and
+/// its left perpendicular.
+/// </summary>
+class skOrientedBox2D
+{
+public:
+    skVector2 center;
+    skVector2 axis;
+    skVector2 extent;
+
+public:
+    skOrientedBox2D() = default;
+
+    skOrientedBox2D(const skOrientedBox2D& box) = default;
+
+    skOrientedBox2D(const skVector2& c, const skVector2& unitAxis, const skVector2& e) :
+        center(c),
+        axis(unitAxis),
+        extent(e)
+    {
+    }
+
+    skOrientedBox2D(const skVector2& c, skScalar angle, const skVector2& e) :
+        center(c),
+        axis(skCos(angle), skSin(angle)),
+        extent(e)
+    {
+    }
+
+    skOrientedBox2D& operator=(const skOrientedBox2D& box) = default;
+
+    SK_INLINE skVector2 perpendicular() const
+    {
+        return skVector2(-axis.y, axis.x);
+    }
+
+    bool contains(const skVector2& point) const;
+
+    /// <summary>
+    /// Separating axis test over the four edge normals.
+    /// </summary>
+    bool overlaps(const skOrientedBox2D& box) const;
+
+    /// <summary>
+    /// Returns the axis aligned box enclosing this one.
+    /// </summary>
+    skBoundingBox2D getBounds() const;
+
+    /// <summary>
+    /// Tests box against every element of boxes and writes the indices
+    /// of the overlapping ones to hits, in order. Returns the number
+    /// written. Single precision tests four boxes at a time.
+    /// </summary>
+    static SKsize overlaps(SKuint32*              hits,
+                           const skOrientedBox2D& box,
+                           const skOrientedBox2D* boxes,
+                           SKsize                 count);
+
+    void print() const;
+};
+
+#endif  //_skOrientedBox2D_h_
@@ -0,0 +1,307 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skOrientedBox3D.h"
+#include <cstdio>
+#include "skCovariance3.h"
+
+namespace
+{
+    // Inflates |R| so that nearly parallel edges, whose cross products
+    // vanish, do not report a false separation.
+    const skScalar ParallelEpsilon = skScalar(1e-6);
+
+    // A box spread over lanes. a[i][k] is component i of axis k.
+    template <typename F>
+    struct BoxLanes
+    {
+        F c[3];
+        F a[3][3];
+        F e[3];
+    };
+
+    template <typename F>
+    void broadcast(BoxLanes<F>& d, const skOrientedBox3D& box)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            d.c[i] = F(box.center.ptr()[i]);
+            d.e[i] = F(box.extent.ptr()[i]);
+            for (int k = 0; k < 3; ++k)
+                d.a[i][k] = F(box.basis.m[i][k]);
+        }
+    }
+
+#ifndef SK_DOUBLE
+    void loadLanes(BoxLanes<skSimd4f>& d, const skOrientedBox3D* box)
+    {
+        float t[15][4];
+        for (int l = 0; l < 4; ++l)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                t[i][l]     = box[l].center.ptr()[i];
+                t[3 + i][l] = box[l].extent.ptr()[i];
+            }
+            for (int i = 0; i < 9; ++i)
+                t[6 + i][l] = box[l].basis.p[i];
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            d.c[i] = skSimd4f::load(t[i]);
+            d.e[i] = skSimd4f::load(t[3 + i]);
+            for (int k = 0; k < 3; ++k)
+                d.a[i][k] = skSimd4f::load(t[6 + 3 * i + k]);
+        }
+    }
+#endif
+
+    // Returns the largest gap between the projections of A and B over
+    // the 15 candidate axes. The boxes overlap when it is not positive.
+    template <typename F>
+    F separation(const BoxLanes<F>& A, const BoxLanes<F>& B)
+    {
+        const F eps(ParallelEpsilon);
+
+        F d[3], t[3], r[3][3], ar[3][3];
+        for (int i = 0; i < 3; ++i)
+            d[i] = B.c[i] - A.c[i];
+
+        // B's axes and the center offset in A's frame.
+        for (int i = 0; i < 3; ++i)
+        {
+            t[i] = d[0] * A.a[0][i] + d[1] * A.a[1][i] + d[2] * A.a[2][i];
+            for (int j = 0; j < 3; ++j)
+            {
+                r[i][j]  = A.a[0][i] * B.a[0][j] + A.a[1][i] * B.a[1][j] + A.a[2][i] * B.a[2][j];
+                ar[i][j] = skSimdAbs(r[i][j]) + eps;
+            }
+        }
+
+        F gap = skSimdAbs(t[0]) - (A.e[0] + B.e[0] * ar[0][0] + B.e[1] * ar[0][1] + B.e[2] * ar[0][2]);
+
+        for (int i = 1; i < 3; ++i)
+        {
+            const F rb = B.e[0] * ar[i][0] + B.e[1] * ar[i][1] + B.e[2] * ar[i][2];
+            gap        = skSimdMax(gap, skSimdAbs(t[i]) - (A.e[i] + rb));
+        }
+
+        for (int j = 0; j < 3; ++j)
+        {
+            const F ra = A.e[0] * ar[0][j] + A.e[1] * ar[1][j] + A.e[2] * ar[2][j];
+            const F tp = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+            gap        = skSimdMax(gap, skSimdAbs(tp) - (ra + B.e[j]));
+        }
+
+        // The nine edge cross products A[i] x B[j].
+        for (int i = 0; i < 3; ++i)
+        {
+            const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+            for (int j = 0; j < 3; ++j)
+            {
+                const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+
+                const F ra = A.e[i1] * ar[i2][j] + A.e[i2] * ar[i1][j];
+                const F rb = B.e[j1] * ar[i][j2] + B.e[j2] * ar[i][j1];
+                const F tp = t[i2] * r[i1][j] - t[i1] * r[i2][j];
+                gap        = skSimdMax(gap, skSimdAbs(tp) - (ra + rb));
+            }
+        }
+        return gap;
+    }
+
+    bool slab(const skOrientedBox3D& box,
+              const skRay&           ray,
+              const skVector2&       limit,
+              skScalar&              t,
+              skVector3*             normal)
+    {
+        const skVector3 o = ray.origin - box.center;
+
+        skScalar tn = -SK_INFINITY, tf = SK_INFINITY;
+        skScalar sn = 0, sf = 0;
+        int      an = 0, af = 0;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            const skVector3 axis = box.axis(k);
+            const skScalar  ok   = axis.dot(o);
+            const skScalar  dk   = axis.dot(ray.direction);
+            const skScalar  ek   = box.extent.ptr()[k];
+
+            if (skIsZero(dk))
+            {
+                if (skAbs(ok) > ek)
+                    return false;
+                continue;
+            }
+
+            skScalar t1 = (-ek - ok) / dk, s1 = -1;
+            skScalar t2 = (ek - ok) / dk, s2 = 1;
+            if (t1 > t2)
+            {
+                skScalar tmp = t1;
+                t1 = t2, t2 = tmp;
+                s1 = 1, s2 = -1;
+            }
+
+            if (t1 > tn)
+                tn = t1, sn = s1, an = k;
+            if (t2 < tf)
+                tf = t2, sf = s2, af = k;
+            if (tn > tf)
+                return false;
+        }
+
+        if (tn >= limit.x && tn <= limit.y)
+        {
+            t = tn;
+            if (normal)
+                *normal = box.axis(an) * sn;
+            return true;
+        }
+        if (tn < limit.x && tf >= limit.x && tf <= limit.y)
+        {
+            t = tf;
+            if (normal)
+                *normal = box.axis(af) * sf;
+            return true;
+        }
+        return false;
+    }
+}  // namespace
+
+void skOrientedBox3D::fromPoints(const skVector3* points, SKsize count)
+{
+    if (count == 0)
+    {
+        center = extent = skVector3::Zero;
+        basis  = skMatrix3::Identity;
+        return;
+    }
+
+    skVector3 variance;
+    skCovariance3::compute(points, count).principalAxes(basis, variance);
+
+    skVector3 lo(SK_INFINITY, SK_INFINITY, SK_INFINITY);
+    skVector3 hi(-SK_INFINITY, -SK_INFINITY, -SK_INFINITY);
+
+    const skVector3 a0 = axis(0), a1 = axis(1), a2 = axis(2);
+    for (SKsize i = 0; i < count; ++i)
+    {
+        const skVector3 l(a0.dot(points[i]), a1.dot(points[i]), a2.dot(points[i]));
+
+        lo = skVector3(skMin(lo.x, l.x), skMin(lo.y, l.y), skMin(lo.z, l.z));
+        hi = skVector3(skMax(hi.x, l.x), skMax(hi.y, l.y), skMax(hi.z, l.z));
+    }
+
+    extent = (hi - lo) * skScalar(0.5);
+    center = basis * ((hi + lo) * skScalar(0.5));
+}
+
+bool skOrientedBox3D::contains(const skVector3& point) const
+{
+    const skVector3 d = point - center;
+    return skAbs(axis(0).dot(d)) <= extent.x &&
+           skAbs(axis(1).dot(d)) <= extent.y &&
+           skAbs(axis(2).dot(d)) <= extent.z;
+}
+
+skBoundingBox3D skOrientedBox3D::getBounds() const
+{
+    skScalar h[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        h[i] = skAbs(basis.m[i][0]) * extent.x +
+               skAbs(basis.m[i][1]) * extent.y +
+               skAbs(basis.m[i][2]) * extent.z;
+    }
+    return skBoundingBox3D(center.x - h[0], center.y - h[1], center.z - h[2],
+                           center.x + h[0], center.y + h[1], center.z + h[2]);
+}
+
+bool skOrientedBox3D::overlaps(const skOrientedBox3D& box) const
+{
+    BoxLanes<skScalar> a, b;
+    broadcast(a, *this);
+    broadcast(b, box);
+    return separation(a, b) <= 0;
+}
+
+bool skOrientedBox3D::hit(skScalar& t, const skRay& ray, const skVector2& limit) const
+{
+    return slab(*this, ray, limit, t, nullptr);
+}
+
+bool skOrientedBox3D::hit(skRayHitTest& ht, const skRay& ray, const skVector2& limit) const
+{
+    if (slab(*this, ray, limit, ht.distance, &ht.normal))
+    {
+        ht.point = ray.at(ht.distance);
+        return true;
+    }
+    return false;
+}
+
+SKsize skOrientedBox3D::overlaps(SKuint32*              hits,
+                                 const skOrientedBox3D& box,
+                                 const skOrientedBox3D* boxes,
+                                 SKsize                 count)
+{
+    SKsize n = 0, i = 0;
+
+#ifndef SK_DOUBLE
+    BoxLanes<skSimd4f> a, b;
+    broadcast(a, box);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        loadLanes(b, boxes + i);
+
+        const skSimd4f gap = separation(a, b);
+        if (!skSimdAny(gap <= skSimd4f(0.f)))
+            continue;
+
+        float g[4];
+        gap.store(g);
+        for (SKuint32 l = 0; l < 4; ++l)
+        {
+            if (g[l] <= 0)
+                hits[n++] = (SKuint32)(i + l);
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (box.overlaps(boxes[i]))
+            hits[n++] = (SKuint32)i;
+    }
+    return n;
+}
+
+void skOrientedBox3D::print() const
+{
+    printf("C[%3.3f, %3.3f, %3.3f]\n", (double)center.x, (double)center.y, (double)center.z);
+    printf("E[%3.3f, %3.3f, %3.3f]\n", (double)extent.x, (double)extent.y, (double)extent.z);
+    basis.print();
+}
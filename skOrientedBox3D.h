@@ -0,0 +1,118 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skOrientedBox3D_h_
+#define _skOrientedBox3D_h_
+
+#include "Math/skBoundingBox3D.h"
+#include "Math/skMatrix3.h"
+#include "Math/skRay.h"
+#include "Math/skVector2.h"
+#include "Math/skVector3.h"
+
+/// <summary>
+/// A box with center c, half extents e along the unit columns of basis,
+/// covering c + basis * [-e, e].
+/// </summary>
+class skOrientedBox3D
+{
+public:
+    skVector3 center;
+    skMatrix3 basis;
+    skVector3 extent;
+
+public:
+    skOrientedBox3D() = default;
+
+    skOrientedBox3D(const skOrientedBox3D& box) = default;
+
+    skOrientedBox3D(const skVector3& c, const skMatrix3& rotation, const skVector3& e) :
+        center(c),
+        basis(rotation),
+        extent(e)
+    {
+    }
+
+    skOrientedBox3D& operator=(const skOrientedBox3D& box) = default;
+
+    /// <summary>
+    /// Returns column idx of basis.
+    /// </summary>
+    SK_INLINE skVector3 axis(const int idx) const
+    {
+        return skVector3(basis.m[0][idx], basis.m[1][idx], basis.m[2][idx]);
+    }
+
+    /// <summary>
+    /// Returns the corner furthest along dir.
+    /// </summary>
+    SK_INLINE skVector3 support(const skVector3& dir) const
+    {
+        skVector3 r = center;
+        for (int k = 0; k < 3; ++k)
+        {
+            const skVector3 a = axis(k);
+            r += a * (a.dot(dir) >= 0 ? extent.ptr()[k] : -extent.ptr()[k]);
+        }
+        return r;
+    }
+
+    /// <summary>
+    /// Fits the box to a point cloud by aligning it with the principal
+    /// axes of the point covariance.
+    /// </summary>
+    void fromPoints(const skVector3* points, SKsize count);
+
+    bool contains(const skVector3& point) const;
+
+    /// <summary>
+    /// Returns the axis aligned box enclosing this one.
+    /// </summary>
+    skBoundingBox3D getBounds() const;
+
+    /// <summary>
+    /// Separating axis test over the 15 candidate axes.
+    /// </summary>
+    bool overlaps(const skOrientedBox3D& box) const;
+
+    /// <summary>
+    /// Slab test in the box frame. Reports the first crossing of the
+    /// surface with limit.x <= t <= limit.y, so a ray that starts inside
+    /// hits the exit face.
+    /// </summary>
+    bool hit(skScalar& t, const skRay& ray, const skVector2& limit) const;
+
+    bool hit(skRayHitTest& ht, const skRay& ray, const skVector2& limit) const;
+
+    /// <summary>
+    /// Tests box against every element of boxes and writes the indices
+    /// of the overlapping ones to hits, in order. Returns the number
+    /// written. Single precision tests four boxes at a time.
+    /// </summary>
+    static SKsize overlaps(SKuint32*              hits,
+                           const skOrientedBox3D& box,
+                           const skOrientedBox3D* boxes,
+                           SKsize                 count);
+
+    void print() const;
+};
+
+#endif  //_skOrientedBox3D_h_
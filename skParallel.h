@@ -0,0 +1,114 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skParallel_h_
+#define _skParallel_h_
+
+#include <thread>
+#include <vector>
+#include "Utils/Config/skConfig.h"
+
+/// <summary>
+/// Splits a range over std::thread workers. The split only depends on
+/// the count, the grain and the thread count, so reductions that merge
+/// the per chunk results in chunk order are deterministic.
+/// </summary>
+class skParallel
+{
+public:
+    /// <summary>
+    /// The hardware thread count, at least one.
+    /// </summary>
+    static SKuint32 threadCount()
+    {
+        const SKuint32 n = std::thread::hardware_concurrency();
+        return n > 0 ? n : 1;
+    }
+
+    /// <summary>
+    /// Returns the number of chunks forChunks splits count items into.
+    /// There are at most threads chunks, zero meaning threadCount(), and
+    /// every chunk but the last holds at least grain items.
+    /// </summary>
+    static SKsize chunkCount(SKsize count, SKsize grain, SKuint32 threads = 0)
+    {
+        const SKsize size = chunkSize(count, grain, threads);
+        return size > 0 ? (count + size - 1) / size : 0;
+    }
+
+    /// <summary>
+    /// Calls fn(chunk, first, last) for each of the chunkCount() chunks
+    /// of [0, count). The calling thread runs chunk zero and the call
+    /// returns when every chunk is done.
+    /// </summary>
+    template <typename Fn>
+    static void forChunks(SKsize count, SKsize grain, Fn&& fn, SKuint32 threads = 0)
+    {
+        const SKsize size = chunkSize(count, grain, threads);
+        if (size == 0)
+            return;
+
+        const SKsize chunks = (count + size - 1) / size;
+
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+
+        for (SKsize c = 1; c < chunks; ++c)
+        {
+            const SKsize first = c * size;
+            const SKsize last  = first + size < count ? first + size : count;
+            workers.emplace_back([&fn, c, first, last] { fn(c, first, last); });
+        }
+
+        fn(SKsize(0), SKsize(0), size < count ? size : count);
+
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    /// <summary>
+    /// Runs a on a new thread and b on the calling one, and returns when
+    /// both are done.
+    /// </summary>
+    template <typename A, typename B>
+    static void invoke(A&& a, B&& b)
+    {
+        std::thread worker(a);
+        b();
+        worker.join();
+    }
+
+private:
+    static SKsize chunkSize(SKsize count, SKsize grain, SKuint32 threads)
+    {
+        if (count == 0)
+            return 0;
+        if (threads == 0)
+            threads = threadCount();
+        if (grain == 0)
+            grain = 1;
+
+        const SKsize size = (count + threads - 1) / threads;
+        return size > grain ? size : grain;
+    }
+};
+
+#endif  //_skParallel_h_
@@ -22,10 +22,37 @@
 #include "skQuaternion.h"
 #include <cstdio>
 
-const skQuaternion skQuaternion::Identity = skQuaternion(1, 0, 0, 0);
-const skQuaternion skQuaternion::Zero     = skQuaternion(0, 0, 0, 0);
-
 void skQuaternion::print() const
 {
     printf("[%3.3f, %3.3f, %3.3f, %3.3f]\n", (double)w, (double)x, (double)y, (double)z);
 }
+
+void skQuaternion::makeRotXYZ(skQuaternion*   dst,
+                              const skScalar* xRad,
+                              const skScalar* yRad,
+                              const skScalar* zRad,
+                              SKsize          count)
+{
+    const SKsize Block = 64;
+
+    skScalar h[3][Block], s[3][Block], c[3][Block];
+
+    for (SKsize b = 0; b < count; b += Block)
+    {
+        const SKsize n = skMin(Block, count - b);
+
+        for (SKsize i = 0; i < n; ++i)
+        {
+            h[0][i] = xRad[b + i] * skScalar(0.5);
+            h[1][i] = yRad[b + i] * skScalar(0.5);
+            h[2][i] = zRad[b + i] * skScalar(0.5);
+        }
+
+        skMath::sinCos(h[0], s[0], c[0], n);
+        skMath::sinCos(h[1], s[1], c[1], n);
+        skMath::sinCos(h[2], s[2], c[2], n);
+
+        for (SKsize i = 0; i < n; ++i)
+            dst[b + i].fromSinCosXYZ(s[0][i], c[0][i], s[1][i], c[1][i], s[2][i], c[2][i]);
+    }
+}
@@ -36,7 +36,7 @@ public:
 public:
     skQuaternion() = default;
 
-    skQuaternion(const skScalar nw, const skScalar nx, const skScalar ny, const skScalar nz) :
+    constexpr skQuaternion(const skScalar nw, const skScalar nx, const skScalar ny, const skScalar nz) :
         w(nw),
         x(nx),
         y(ny),
@@ -54,7 +54,7 @@ public:
         (*this).makeRotXYZ(vec.x, vec.y, vec.z);
     }
 
-    explicit skQuaternion(const skScalar* p) :
+    constexpr explicit skQuaternion(const skScalar* p) :
         w(p[0]),
         x(p[1]),
         y(p[2]),
@@ -64,7 +64,7 @@ public:
 
     skQuaternion(const skQuaternion& v) = default;
 
-    void makeIdentity()
+    constexpr void makeIdentity()
     {
         w = 1;
         x = y = z = 0;
@@ -72,15 +72,40 @@ public:
 
     void makeRotXYZ(const skScalar xRad, const skScalar yRad, const skScalar zRad)
     {
-        skQuaternion q0, q1, q2;
-        q0.makeRotX(xRad);
-        q1.makeRotY(yRad);
-        q2.makeRotZ(zRad);
+        skScalar sx, cx, sy, cy, sz, cz;
+        skMath::sinCos(xRad * skScalar(0.5), sx, cx);
+        skMath::sinCos(yRad * skScalar(0.5), sy, cy);
+        skMath::sinCos(zRad * skScalar(0.5), sz, cz);
+        fromSinCosXYZ(sx, cx, sy, cy, sz, cz);
+    }
 
-        *this = q2 * q1 * q0;
-        this->normalize();
+    /// <summary>
+    /// Builds the makeRotXYZ rotation, qz * qy * qx, from the sine and
+    /// cosine of the half angles.
+    /// </summary>
+    constexpr void fromSinCosXYZ(const skScalar sx,
+                                 const skScalar cx,
+                                 const skScalar sy,
+                                 const skScalar cy,
+                                 const skScalar sz,
+                                 const skScalar cz)
+    {
+        w = cz * cy * cx + sz * sy * sx;
+        x = cz * cy * sx - sz * sy * cx;
+        y = cz * sy * cx + sz * cy * sx;
+        z = sz * cy * cx - cz * sy * sx;
     }
 
+    /// <summary>
+    /// Bulk form of makeRotXYZ for count sets of angles in radians.
+    /// The sines and cosines are computed in blocks with skMath::sinCos.
+    /// </summary>
+    static void makeRotXYZ(skQuaternion*   dst,
+                           const skScalar* xRad,
+                           const skScalar* yRad,
+                           const skScalar* zRad,
+                           SKsize          count);
+
     void makeRotX(const skScalar v)
     {
         skMath::sinCos(v * skScalar(0.5), x, w);
@@ -139,17 +164,17 @@ public:
         return q;
     }
 
-    skQuaternion inverse() const
+    constexpr skQuaternion inverse() const
     {
         return skQuaternion(w, -x, -y, -z);
     }
 
-    skQuaternion operator-() const
+    constexpr skQuaternion operator-() const
     {
         return skQuaternion(w, -x, -y, -z);
     }
 
-    skQuaternion& invert()
+    constexpr skQuaternion& invert()
     {
         x = -x;
         y = -y;
@@ -157,12 +182,12 @@ public:
         return *this;
     }
 
-    skQuaternion operator*(const skScalar& v) const
+    constexpr skQuaternion operator*(const skScalar& v) const
     {
         return skQuaternion(w * v, x * v, y * v, z * v);
     }
 
-    skQuaternion& operator*=(const skScalar& v)
+    constexpr skQuaternion& operator*=(const skScalar& v)
     {
         w *= v;
         x *= v;
@@ -171,7 +196,7 @@ public:
         return *this;
     }
 
-    skQuaternion& operator*=(const skQuaternion& v)
+    constexpr skQuaternion& operator*=(const skQuaternion& v)
     {
         w = w * v.w - x * v.x - y * v.y - z * v.z;
         x = w * v.x + x * v.w + y * v.z - z * v.y;
@@ -180,7 +205,7 @@ public:
         return *this;
     }
 
-    skQuaternion operator*(const skQuaternion& v) const
+    constexpr skQuaternion operator*(const skQuaternion& v) const
     {
         return skQuaternion(
             w * v.w - x * v.x - y * v.y - z * v.z,
@@ -189,7 +214,7 @@ public:
             w * v.z + z * v.w + x * v.y - y * v.x);
     }
 
-    skVector3 operator*(const skVector3& v) const
+    constexpr skVector3 operator*(const skVector3& v) const
     {
         const skVector3 c(x, y, z);
 
@@ -200,37 +225,37 @@ public:
         return v + a + b;
     }
 
-    skQuaternion operator+(const skScalar& v) const
+    constexpr skQuaternion operator+(const skScalar& v) const
     {
         return skQuaternion(w + v, x + v, y + v, z + v);
     }
 
-    skQuaternion operator+(const skQuaternion& v) const
+    constexpr skQuaternion operator+(const skQuaternion& v) const
     {
         return skQuaternion(w + v.w, x + v.x, y + v.y, z + v.z);
     }
 
-    skQuaternion operator-(const skScalar& v) const
+    constexpr skQuaternion operator-(const skScalar& v) const
     {
         return skQuaternion(w - v, x - v, y - v, z - v);
     }
 
-    skQuaternion operator-(const skQuaternion& v) const
+    constexpr skQuaternion operator-(const skQuaternion& v) const
     {
         return skQuaternion(w - v.w, x - v.x, y - v.y, z - v.z);
     }
 
-    SK_INLINE bool operator==(const skQuaternion& v) const
+    SK_INLINE constexpr bool operator==(const skQuaternion& v) const
     {
         return skEq(x, v.x) && skEq(y, v.y) && skEq(z, v.z) && skEq(w, v.w);
     }
 
-    SK_INLINE bool operator!=(const skQuaternion& v) const
+    SK_INLINE constexpr bool operator!=(const skQuaternion& v) const
     {
         return skNeq(x, v.x) && skNeq(y, v.y) && skNeq(z, v.z) && skNeq(w, v.w);
     }
 
-    SK_INLINE skScalar length2() const
+    SK_INLINE constexpr skScalar length2() const
     {
         return w * w + x * x + y * y + z * z;
     }
@@ -248,4 +273,13 @@ public:
     void print() const;
 };
 
+inline constexpr skQuaternion skQuaternion::Identity = skQuaternion(1, 0, 0, 0);
+inline constexpr skQuaternion skQuaternion::Zero     = skQuaternion(0, 0, 0, 0);
+
+/// <summary>
+/// skQuaternion aligned to its size, so that it is one aligned SIMD
+/// load in single precision.
+/// </summary>
+typedef skAligned<skQuaternion, 4 * sizeof(skScalar)> skQuaternionA;
+
 #endif  //_skQuaternion_h_
@@ -21,16 +21,109 @@
 */
 #include "skRational.h"
 #include <cstdio>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__SIZEOF_INT128__)
+#define SK_RATIONAL_WIDE
+typedef __int128 skRationalWide;
+#endif
+
+// The representable range is kept symmetric so negation never overflows.
+const SKint64 SK_RATIONAL_MAX = 0x7FFFFFFFFFFFFFFFLL;
 
 const skRational skRational::Zero = skRational();
 
+static SK_INLINE int skCountTrailingZeros(SKuint64 v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long r;
+    _BitScanForward64(&r, v);
+    return (int)r;
+#else
+    int r = 0;
+    while ((v & 1) == 0)
+    {
+        v >>= 1;
+        ++r;
+    }
+    return r;
+#endif
+}
+
+static SK_INLINE SKuint64 skMagnitude(SKint64 v)
+{
+    return v < 0 ? SKuint64(0) - SKuint64(v) : SKuint64(v);
+}
+
+static SKuint64 skBinaryGcd(SKuint64 u, SKuint64 v)
+{
+    if (u == 0)
+        return v;
+    if (v == 0)
+        return u;
+
+    // Stein's algorithm: factor out the common power of two, then
+    // subtract the smaller odd value from the larger until they meet.
+    const int shift = skCountTrailingZeros(u | v);
+    u >>= skCountTrailingZeros(u);
+    do
+    {
+        v >>= skCountTrailingZeros(v);
+        if (u > v)
+        {
+            const SKuint64 t = v;
+            v                = u;
+            u                = t;
+        }
+        v -= u;
+    } while (v != 0);
+
+    return u << shift;
+}
+
+static SK_INLINE bool skMulChecked(SKint64& r, SKint64 a, SKint64 b)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_mul_overflow(a, b, &r) && r >= -SK_RATIONAL_MAX;
+#else
+    const SKuint64 ua = skMagnitude(a), ub = skMagnitude(b);
+    if (ub != 0 && ua > SKuint64(SK_RATIONAL_MAX) / ub)
+        return false;
+    r = a * b;
+    return true;
+#endif
+}
+
+static SK_INLINE bool skAddChecked(SKint64& r, SKint64 a, SKint64 b)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return !__builtin_add_overflow(a, b, &r) && r >= -SK_RATIONAL_MAX;
+#else
+    if (b > 0 ? a > SK_RATIONAL_MAX - b : a < -SK_RATIONAL_MAX - b)
+        return false;
+    r = a + b;
+    return true;
+#endif
+}
+
+static SK_INLINE bool skOverflow(skRational& r)
+{
+    r.n = 0;
+    r.d = 0;
+    return false;
+}
+
 skRational::skRational() :
     n(0),
     d(1)
 {
 }
 
-skRational::skRational(int rn, int rd) :
+skRational::skRational(SKint64 rn, SKint64 rd) :
     n(rn),
     d(rd)
 {
@@ -43,101 +136,189 @@ skRational::skRational(int rn, int rd) :
         reduce();
 }
 
-skRational::skRational(const skRational& oth) :
-    n(oth.n),
-    d(oth.d)
+SKint64 skRational::gcd(SKint64 a, SKint64 b)
+{
+    return (SKint64)skBinaryGcd(skMagnitude(a), skMagnitude(b));
+}
+
+void skRational::reduce()
 {
+    // An overflowed value has no meaningful reduction.
     if (d == 0)
+        return;
+
+    const bool neg = (n < 0) != (d < 0);
+
+    SKuint64       un = skMagnitude(n);
+    SKuint64       ud = skMagnitude(d);
+    const SKuint64 g  = skBinaryGcd(un, ud);
+    un /= g;
+    ud /= g;
+
+    if (un > SKuint64(SK_RATIONAL_MAX) || ud > SKuint64(SK_RATIONAL_MAX))
     {
-        n = Zero.n;
-        d = Zero.d;
+        skOverflow(*this);
+        return;
+    }
+
+    if (un == 0)
+    {
+        n = 0;
+        d = 1;
     }
     else
-        reduce();
+    {
+        n = neg ? -SKint64(un) : SKint64(un);
+        d = SKint64(ud);
+    }
 }
 
-int skRational::gcd(int a, int b)
+skRational skRational::operator-() const
 {
-    if (b == 0)
-        return a;
-    return gcd(b, a % b);
+    skRational r;
+    r.n = -n;
+    r.d = d;
+    return r;
 }
 
-void skRational::reduce()
+void skRational::print() const
 {
     if (d == 0)
+        printf("nan\n");
+    else if (d == 1)
+        printf("%lld\n", (long long)n);
+    else
+        printf("%lld/%lld\n", (long long)n, (long long)d);
+}
+
+bool skRational::add(skRational& r, const skRational& a, const skRational& b)
+{
+    if (a.d == 0 || b.d == 0)
+        return skOverflow(r);
+
+    if (a.d == 1 && b.d == 1)
     {
-        // Math Error: division by zero.
-        n = 0;
-        d = 1;
+        if (!skAddChecked(r.n, a.n, b.n))
+            return skOverflow(r);
+        r.d = 1;
+        return true;
     }
 
-    int g = gcd(n < 0 ? -n : n, d < 0 ? -d : d);
-    n /= g;
-    d /= g;
+    // Knuth 4.5.1: with g = gcd(a.d, b.d), the sum
+    // t = a.n * (b.d / g) + b.n * (a.d / g) only shares factors with g.
+    const SKint64 g  = (SKint64)skBinaryGcd(SKuint64(a.d), SKuint64(b.d));
+    const SKint64 ad = a.d / g;
+    const SKint64 bd = b.d / g;
 
-    if (d < 0)
+    SKint64 t0, t1, t;
+    if (skMulChecked(t0, a.n, bd) && skMulChecked(t1, b.n, ad) && skAddChecked(t, t0, t1))
     {
-        n *= -1;
-        d *= -1;
+        const SKint64 g2 = (SKint64)skBinaryGcd(skMagnitude(t), SKuint64(g));
+        if (!skMulChecked(r.d, ad, b.d / g2))
+            return skOverflow(r);
+
+        r.n = t / g2;
+        if (r.n == 0)
+            r.d = 1;
+        return true;
     }
-    if (n == 0)
-        d = 1;
-    if (n == d)
-        d = 1;
-}
 
-skRational skRational::operator-() const
-{
-    return skRational(-n, d);
+#ifdef SK_RATIONAL_WIDE
+    // The numerator overflowed 64 bits, retry with a 128-bit intermediate
+    // since the reduced result may still fit.
+    const skRationalWide wt = (skRationalWide)a.n * bd + (skRationalWide)b.n * ad;
+    const SKint64        g2 = (SKint64)skBinaryGcd(skMagnitude((SKint64)(wt % g)), SKuint64(g));
+    const skRationalWide wn = wt / g2;
+
+    if (wn > SK_RATIONAL_MAX || wn < -SK_RATIONAL_MAX)
+        return skOverflow(r);
+    if (!skMulChecked(r.d, ad, b.d / g2))
+        return skOverflow(r);
+
+    r.n = (SKint64)wn;
+    return true;
+#else
+    return skOverflow(r);
+#endif
 }
 
-void skRational::print() const
+bool skRational::sub(skRational& r, const skRational& a, const skRational& b)
 {
-    if (d == 1)
-        printf("%d\n", n);
-    else
-        printf("%d/%d\n", n, d);
+    return add(r, a, -b);
 }
 
-skRational operator+(const skRational& a, const skRational& b)
+bool skRational::mul(skRational& r, const skRational& a, const skRational& b)
 {
-    skRational r;
-    if (a.d == b.d)
+    if (a.d == 0 || b.d == 0)
+        return skOverflow(r);
+
+    if (a.n == 0 || b.n == 0)
     {
-        r.d = a.d;
-        r.n = a.n + b.n;
+        r.n = 0;
+        r.d = 1;
+        return true;
     }
-    else
+
+    if (a.d == 1 && b.d == 1)
+    {
+        if (!skMulChecked(r.n, a.n, b.n))
+            return skOverflow(r);
+        r.d = 1;
+        return true;
+    }
+
+    // Cross-cancel before multiplying, both inputs are already in lowest
+    // terms so the product is too, and it overflows only if the result does.
+    const SKint64 g1 = (SKint64)skBinaryGcd(skMagnitude(a.n), SKuint64(b.d));
+    const SKint64 g2 = (SKint64)skBinaryGcd(skMagnitude(b.n), SKuint64(a.d));
+
+    if (!skMulChecked(r.n, a.n / g1, b.n / g2) || !skMulChecked(r.d, a.d / g2, b.d / g1))
+        return skOverflow(r);
+    return true;
+}
+
+bool skRational::div(skRational& r, const skRational& a, const skRational& b)
+{
+    if (a.d == 0 || b.d == 0)
+        return skOverflow(r);
+
+    if (b.n == 0)
     {
-        int na, nb, cd;
-        na  = a.n * b.d;
-        nb  = b.n * a.d;
-        cd  = b.d * a.d;
-        r.n = na + nb;
-        r.d = cd;
+        // Math Error: division by zero.
+        r = Zero;
+        return false;
     }
-    r.reduce();
+
+    skRational t;
+    t.n = b.n < 0 ? -b.d : b.d;
+    t.d = b.n < 0 ? -b.n : b.n;
+    return mul(r, a, t);
+}
+
+skRational operator+(const skRational& a, const skRational& b)
+{
+    skRational r;
+    skRational::add(r, a, b);
     return r;
 }
 
 skRational operator-(const skRational& a, const skRational& b)
 {
-    return skRational(a + (-b));
+    skRational r;
+    skRational::sub(r, a, b);
+    return r;
 }
 
 skRational operator*(const skRational& a, const skRational& b)
 {
-    return skRational(a.n * b.n, a.d * b.d);
+    skRational r;
+    skRational::mul(r, a, b);
+    return r;
 }
 
 skRational operator/(const skRational& a, const skRational& b)
 {
-    if (b.n == 0)
-    {
-        //DivisionByZero(a, b, std::cout);
-        return skRational::Zero;
-    }
-    const skRational t(b.d, b.n);
-    return a * t;
+    skRational r;
+    skRational::div(r, a, b);
+    return r;
 }
@@ -24,27 +24,59 @@
 
 #include "Math/skMath.h"
 
+/// <summary>
+/// Exact fraction n/d stored in 64-bit integers.
+///
+/// Values are always kept in lowest terms with a positive denominator.
+/// Operations cancel common factors before multiplying, so intermediate
+/// products only overflow when the reduced result itself does not fit.
+/// A result that cannot be represented is flagged by d == 0, it converts
+/// to NaN and propagates through any further operations.
+/// </summary>
 class skRational
 {
 public:
     static const skRational Zero;
-    int                     n, d;
+    SKint64                 n, d;
 
 public:
     skRational();
-    skRational(int n, int d);
-    skRational(const skRational& oth);
+    skRational(SKint64 n, SKint64 d);
+    skRational(const skRational& oth) = default;
+
+    skRational& operator=(const skRational& oth) = default;
 
     skRational operator-() const;
 
     explicit operator skScalar() const
     {
         if (d == 0)
-            return (skScalar)(SK_INFINITY * 0);
+            return (skScalar)SK_NAN;
         return (skScalar)n / (skScalar)d;
     }
 
-    static int gcd(int a, int b);
+    /// <summary>
+    /// Returns false if the value overflowed during an operation.
+    /// </summary>
+    SK_INLINE bool isValid() const
+    {
+        return d != 0;
+    }
+
+    /// <summary>
+    /// Binary (Stein's) greatest common divisor of |a| and |b|.
+    /// </summary>
+    static SKint64 gcd(SKint64 a, SKint64 b);
+
+    /// <summary>
+    /// Checked arithmetic. Each function stores the reduced result in r
+    /// and returns false if the result overflowed 64 bits, or in the case
+    /// of div, if b is zero.
+    /// </summary>
+    static bool add(skRational& r, const skRational& a, const skRational& b);
+    static bool sub(skRational& r, const skRational& a, const skRational& b);
+    static bool mul(skRational& r, const skRational& a, const skRational& b);
+    static bool div(skRational& r, const skRational& a, const skRational& b);
 
     void reduce();
     void print() const;
@@ -22,6 +22,8 @@
 #ifndef _skRay_h_
 #define _skRay_h_
 
+#include <cmath>
+#include <limits>
 #include "Math/skMath.h"
 #include "Math/skVector3.h"
 
@@ -80,4 +82,46 @@ public:
     void print() const;
 };
 
+/// <summary>
+/// A ray prepared for repeated box tests. The reciprocal direction and
+/// the direction signs are computed once here instead of in every test.
+/// A zero direction component gives an infinite reciprocal, which the
+/// box tests handle.
+/// </summary>
+class skTraversalRay
+{
+public:
+    skVector3 origin;
+    skVector3 direction;
+    skVector3 inverse;
+
+    /// <summary>
+    /// sign[k] is 1 when direction component k is negative.
+    /// </summary>
+    SKuint32 sign[3];
+
+    skScalar tmin, tmax;
+
+public:
+    skTraversalRay(const skRay& ray, skScalar t0 = 0, skScalar t1 = SK_INFINITY) :
+        origin(ray.origin),
+        direction(ray.direction),
+        tmin(t0),
+        tmax(t1)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            const skScalar d = direction.ptr()[k];
+
+            inverse.ptr()[k] = d != 0 ? 1 / d : std::copysign(std::numeric_limits<skScalar>::infinity(), d);
+            sign[k]          = std::signbit(d) ? 1 : 0;
+        }
+    }
+
+    SK_INLINE skVector3 at(const skScalar& t) const
+    {
+        return origin + direction * t;
+    }
+};
+
 #endif  //_skRay_h_
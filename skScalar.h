@@ -46,5 +46,13 @@ typedef double skScalar;
 typedef float skScalar;
 #endif
 
+// Definitions in the *.inl files are marked with SK_MATH_INL. With
+// SK_MATH_HEADER_ONLY they are included by the header and inlined into the
+// caller, otherwise they are compiled once into the library.
+#ifdef SK_MATH_HEADER_ONLY
+#define SK_MATH_INL SK_INLINE
+#else
+#define SK_MATH_INL
+#endif
 
 #endif//_skScalar_h_
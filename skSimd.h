@@ -0,0 +1,900 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSimd_h_
+#define _skSimd_h_
+
+#include "skScalar.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SK_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+// The wider lane types only exist in translation units compiled for
+// the instruction set, see skSimdDispatch.
+#if defined(__AVX2__)
+#define SK_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX512F__)
+#define SK_SIMD_AVX512
+#endif
+
+// The free lane functions below are static. The dispatch units include
+// this header with wider instruction sets enabled, and a shared inline
+// copy emitted there could be the one the linker keeps for every caller.
+
+/// <summary>
+/// Four float lanes. Maps onto SSE2 registers when available and onto a
+/// plain array otherwise, so code written against it runs everywhere.
+/// Comparisons return lane masks with all bits set in the true lanes.
+/// </summary>
+class skSimd4f
+{
+public:
+#ifdef SK_SIMD_SSE2
+    __m128 v;
+
+    skSimd4f() = default;
+
+    SK_INLINE skSimd4f(__m128 r) :
+        v(r)
+    {
+    }
+
+    SK_INLINE explicit skSimd4f(float s) :
+        v(_mm_set1_ps(s))
+    {
+    }
+
+    SK_INLINE static skSimd4f load(const float* p)
+    {
+        return _mm_loadu_ps(p);
+    }
+
+    SK_INLINE void store(float* p) const
+    {
+        _mm_storeu_ps(p, v);
+    }
+
+    SK_INLINE skSimd4f operator+(const skSimd4f& r) const { return _mm_add_ps(v, r.v); }
+    SK_INLINE skSimd4f operator-(const skSimd4f& r) const { return _mm_sub_ps(v, r.v); }
+    SK_INLINE skSimd4f operator*(const skSimd4f& r) const { return _mm_mul_ps(v, r.v); }
+    SK_INLINE skSimd4f operator/(const skSimd4f& r) const { return _mm_div_ps(v, r.v); }
+    SK_INLINE skSimd4f operator&(const skSimd4f& r) const { return _mm_and_ps(v, r.v); }
+    SK_INLINE skSimd4f operator|(const skSimd4f& r) const { return _mm_or_ps(v, r.v); }
+    SK_INLINE skSimd4f operator^(const skSimd4f& r) const { return _mm_xor_ps(v, r.v); }
+    SK_INLINE skSimd4f operator<(const skSimd4f& r) const { return _mm_cmplt_ps(v, r.v); }
+    SK_INLINE skSimd4f operator<=(const skSimd4f& r) const { return _mm_cmple_ps(v, r.v); }
+    SK_INLINE skSimd4f operator>(const skSimd4f& r) const { return _mm_cmpgt_ps(v, r.v); }
+    SK_INLINE skSimd4f operator>=(const skSimd4f& r) const { return _mm_cmpge_ps(v, r.v); }
+    SK_INLINE skSimd4f operator==(const skSimd4f& r) const { return _mm_cmpeq_ps(v, r.v); }
+    SK_INLINE skSimd4f operator!=(const skSimd4f& r) const { return _mm_cmpneq_ps(v, r.v); }
+
+    SK_INLINE skSimd4f operator-() const
+    {
+        return _mm_xor_ps(v, _mm_set1_ps(-0.f));
+    }
+#else
+    float v[4];
+
+    skSimd4f() = default;
+
+    SK_INLINE explicit skSimd4f(float s)
+    {
+        v[0] = v[1] = v[2] = v[3] = s;
+    }
+
+    SK_INLINE static skSimd4f load(const float* p)
+    {
+        skSimd4f r;
+        memcpy(r.v, p, sizeof(r.v));
+        return r;
+    }
+
+    SK_INLINE void store(float* p) const
+    {
+        memcpy(p, v, sizeof(v));
+    }
+
+#define SK_SIMD4F_ARITH(op)                                 \
+    SK_INLINE skSimd4f operator op(const skSimd4f& r) const \
+    {                                                       \
+        skSimd4f d;                                         \
+        for (int i = 0; i < 4; ++i)                         \
+            d.v[i] = v[i] op r.v[i];                        \
+        return d;                                           \
+    }
+#define SK_SIMD4F_BITS(op)                                  \
+    SK_INLINE skSimd4f operator op(const skSimd4f& r) const \
+    {                                                       \
+        skSimd4f d;                                         \
+        for (int i = 0; i < 4; ++i)                         \
+        {                                                   \
+            SKuint32 a, b;                                  \
+            memcpy(&a, &v[i], 4);                           \
+            memcpy(&b, &r.v[i], 4);                         \
+            a = a op b;                                     \
+            memcpy(&d.v[i], &a, 4);                         \
+        }                                                   \
+        return d;                                           \
+    }
+#define SK_SIMD4F_CMP(op)                                   \
+    SK_INLINE skSimd4f operator op(const skSimd4f& r) const \
+    {                                                       \
+        skSimd4f d;                                         \
+        for (int i = 0; i < 4; ++i)                         \
+        {                                                   \
+            const SKuint32 m = v[i] op r.v[i] ? ~0u : 0u;   \
+            memcpy(&d.v[i], &m, 4);                         \
+        }                                                   \
+        return d;                                           \
+    }
+
+    SK_SIMD4F_ARITH(+)
+    SK_SIMD4F_ARITH(-)
+    SK_SIMD4F_ARITH(*)
+    SK_SIMD4F_ARITH(/)
+    SK_SIMD4F_BITS(&)
+    SK_SIMD4F_BITS(|)
+    SK_SIMD4F_BITS(^)
+    SK_SIMD4F_CMP(<)
+    SK_SIMD4F_CMP(<=)
+    SK_SIMD4F_CMP(>)
+    SK_SIMD4F_CMP(>=)
+    SK_SIMD4F_CMP(==)
+    SK_SIMD4F_CMP(!=)
+
+#undef SK_SIMD4F_ARITH
+#undef SK_SIMD4F_BITS
+#undef SK_SIMD4F_CMP
+
+    SK_INLINE skSimd4f operator-() const
+    {
+        skSimd4f d;
+        for (int i = 0; i < 4; ++i)
+            d.v[i] = -v[i];
+        return d;
+    }
+#endif
+};
+
+/// <summary>
+/// Four 32 bit integer lanes, the integer companion of skSimd4f.
+/// </summary>
+class skSimd4i
+{
+public:
+#ifdef SK_SIMD_SSE2
+    __m128i v;
+
+    skSimd4i() = default;
+
+    SK_INLINE skSimd4i(__m128i r) :
+        v(r)
+    {
+    }
+
+    SK_INLINE explicit skSimd4i(SKint32 s) :
+        v(_mm_set1_epi32(s))
+    {
+    }
+
+    SK_INLINE skSimd4i operator+(const skSimd4i& r) const { return _mm_add_epi32(v, r.v); }
+    SK_INLINE skSimd4i operator-(const skSimd4i& r) const { return _mm_sub_epi32(v, r.v); }
+    SK_INLINE skSimd4i operator&(const skSimd4i& r) const { return _mm_and_si128(v, r.v); }
+    SK_INLINE skSimd4i operator|(const skSimd4i& r) const { return _mm_or_si128(v, r.v); }
+    SK_INLINE skSimd4i operator^(const skSimd4i& r) const { return _mm_xor_si128(v, r.v); }
+    SK_INLINE skSimd4i operator==(const skSimd4i& r) const { return _mm_cmpeq_epi32(v, r.v); }
+    SK_INLINE skSimd4i operator<<(int n) const { return _mm_slli_epi32(v, n); }
+    SK_INLINE skSimd4i operator>>(int n) const { return _mm_srai_epi32(v, n); }
+#else
+    SKint32 v[4];
+
+    skSimd4i() = default;
+
+    SK_INLINE explicit skSimd4i(SKint32 s)
+    {
+        v[0] = v[1] = v[2] = v[3] = s;
+    }
+
+#define SK_SIMD4I_OP(op, expr)                              \
+    SK_INLINE skSimd4i operator op(const skSimd4i& r) const \
+    {                                                       \
+        skSimd4i d;                                         \
+        for (int i = 0; i < 4; ++i)                         \
+            d.v[i] = (SKint32)(expr);                       \
+        return d;                                           \
+    }
+
+    SK_SIMD4I_OP(+, (SKuint32)v[i] + (SKuint32)r.v[i])
+    SK_SIMD4I_OP(-, (SKuint32)v[i] - (SKuint32)r.v[i])
+    SK_SIMD4I_OP(&, v[i] & r.v[i])
+    SK_SIMD4I_OP(|, v[i] | r.v[i])
+    SK_SIMD4I_OP(^, v[i] ^ r.v[i])
+    SK_SIMD4I_OP(==, v[i] == r.v[i] ? -1 : 0)
+
+#undef SK_SIMD4I_OP
+
+    SK_INLINE skSimd4i operator<<(int n) const
+    {
+        skSimd4i d;
+        for (int i = 0; i < 4; ++i)
+            d.v[i] = (SKint32)((SKuint32)v[i] << n);
+        return d;
+    }
+
+    SK_INLINE skSimd4i operator>>(int n) const
+    {
+        skSimd4i d;
+        for (int i = 0; i < 4; ++i)
+            d.v[i] = v[i] >> n;
+        return d;
+    }
+#endif
+};
+
+#ifdef SK_SIMD_SSE2
+
+static SK_INLINE skSimd4f skSimdMin(const skSimd4f& a, const skSimd4f& b)
+{
+    return _mm_min_ps(a.v, b.v);
+}
+
+static SK_INLINE skSimd4f skSimdMax(const skSimd4f& a, const skSimd4f& b)
+{
+    return _mm_max_ps(a.v, b.v);
+}
+
+static SK_INLINE skSimd4f skSimdSqrt(const skSimd4f& a)
+{
+    return _mm_sqrt_ps(a.v);
+}
+
+/// <summary>
+/// Hardware reciprocal square root estimate, 12 bits of precision.
+/// </summary>
+static SK_INLINE skSimd4f skSimdRSqrtEst(const skSimd4f& a)
+{
+    return _mm_rsqrt_ps(a.v);
+}
+
+/// <summary>
+/// Returns a in the lanes where mask is set and b in the others.
+/// </summary>
+static SK_INLINE skSimd4f skSimdSelect(const skSimd4f& mask, const skSimd4f& a, const skSimd4f& b)
+{
+    return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));
+}
+
+static SK_INLINE skSimd4f skSimdSelect(const skSimd4i& mask, const skSimd4f& a, const skSimd4f& b)
+{
+    return skSimdSelect(_mm_castsi128_ps(mask.v), a, b);
+}
+
+static SK_INLINE skSimd4i skSimdSelect(const skSimd4i& mask, const skSimd4i& a, const skSimd4i& b)
+{
+    return _mm_or_si128(_mm_and_si128(mask.v, a.v), _mm_andnot_si128(mask.v, b.v));
+}
+
+/// <summary>
+/// Converts with truncation toward zero.
+/// </summary>
+static SK_INLINE skSimd4i skSimdTrunc(const skSimd4f& a)
+{
+    return _mm_cvttps_epi32(a.v);
+}
+
+static SK_INLINE skSimd4f skSimdToFloat(const skSimd4i& a)
+{
+    return _mm_cvtepi32_ps(a.v);
+}
+
+static SK_INLINE skSimd4i skSimdAsInt(const skSimd4f& a)
+{
+    return _mm_castps_si128(a.v);
+}
+
+static SK_INLINE skSimd4f skSimdAsFloat(const skSimd4i& a)
+{
+    return _mm_castsi128_ps(a.v);
+}
+
+/// <summary>
+/// Returns true if any lane of the mask is set.
+/// </summary>
+static SK_INLINE bool skSimdAny(const skSimd4f& mask)
+{
+    return _mm_movemask_ps(mask.v) != 0;
+}
+
+/// <summary>
+/// Packs the sign bit of each lane of the mask into bits 0 to 3.
+/// </summary>
+static SK_INLINE int skSimdMask(const skSimd4f& mask)
+{
+    return _mm_movemask_ps(mask.v);
+}
+
+#else
+
+static SK_INLINE skSimd4f skSimdMin(const skSimd4f& a, const skSimd4f& b)
+{
+    skSimd4f d;
+    for (int i = 0; i < 4; ++i)
+        d.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i];
+    return d;
+}
+
+static SK_INLINE skSimd4f skSimdMax(const skSimd4f& a, const skSimd4f& b)
+{
+    skSimd4f d;
+    for (int i = 0; i < 4; ++i)
+        d.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i];
+    return d;
+}
+
+static SK_INLINE skSimd4f skSimdSqrt(const skSimd4f& a)
+{
+    skSimd4f d;
+    for (int i = 0; i < 4; ++i)
+        d.v[i] = sqrtf(a.v[i]);
+    return d;
+}
+
+static SK_INLINE skSimd4f skSimdRSqrtEst(const skSimd4f& a)
+{
+    skSimd4f d;
+    for (int i = 0; i < 4; ++i)
+        d.v[i] = 1.f / sqrtf(a.v[i]);
+    return d;
+}
+
+static SK_INLINE skSimd4i skSimdAsInt(const skSimd4f& a)
+{
+    skSimd4i d;
+    memcpy(d.v, a.v, sizeof(d.v));
+    return d;
+}
+
+static SK_INLINE skSimd4f skSimdAsFloat(const skSimd4i& a)
+{
+    skSimd4f d;
+    memcpy(d.v, a.v, sizeof(d.v));
+    return d;
+}
+
+static SK_INLINE skSimd4i skSimdSelect(const skSimd4i& mask, const skSimd4i& a, const skSimd4i& b)
+{
+    skSimd4i d;
+    for (int i = 0; i < 4; ++i)
+        d.v[i] = (mask.v[i] & a.v[i]) | (~mask.v[i] & b.v[i]);
+    return d;
+}
+
+static SK_INLINE skSimd4f skSimdSelect(const skSimd4i& mask, const skSimd4f& a, const skSimd4f& b)
+{
+    return skSimdAsFloat(skSimdSelect(mask, skSimdAsInt(a), skSimdAsInt(b)));
+}
+
+static SK_INLINE skSimd4f skSimdSelect(const skSimd4f& mask, const skSimd4f& a, const skSimd4f& b)
+{
+    return skSimdSelect(skSimdAsInt(mask), a, b);
+}
+
+static SK_INLINE skSimd4i skSimdTrunc(const skSimd4f& a)
+{
+    skSimd4i d;
+    for (int i = 0; i < 4; ++i)
+        d.v[i] = (SKint32)a.v[i];
+    return d;
+}
+
+static SK_INLINE skSimd4f skSimdToFloat(const skSimd4i& a)
+{
+    skSimd4f d;
+    for (int i = 0; i < 4; ++i)
+        d.v[i] = (float)a.v[i];
+    return d;
+}
+
+static SK_INLINE bool skSimdAny(const skSimd4f& mask)
+{
+    const skSimd4i m = skSimdAsInt(mask);
+    return (m.v[0] | m.v[1] | m.v[2] | m.v[3]) != 0;
+}
+
+static SK_INLINE int skSimdMask(const skSimd4f& mask)
+{
+    const skSimd4i m = skSimdAsInt(mask);
+    return (m.v[0] < 0 ? 1 : 0) | (m.v[1] < 0 ? 2 : 0) | (m.v[2] < 0 ? 4 : 0) | (m.v[3] < 0 ? 8 : 0);
+}
+
+#endif
+
+static SK_INLINE skSimd4f skSimdAbs(const skSimd4f& a)
+{
+    return skSimdAsFloat(skSimdAsInt(a) & skSimd4i(0x7FFFFFFF));
+}
+
+/// <summary>
+/// Rounds toward negative infinity. Valid while |a| fits in 32 bits.
+/// </summary>
+static SK_INLINE skSimd4f skSimdFloor(const skSimd4f& a)
+{
+    // Floats of magnitude 2^23 and up are already integral, and the
+    // truncation is only valid below 2^31.
+    const skSimd4f t = skSimdToFloat(skSimdTrunc(a));
+    const skSimd4f f = skSimdSelect(t > a, t - skSimd4f(1.f), t);
+    return skSimdSelect(skSimdAbs(a) < skSimd4f(8388608.f), f, a);
+}
+
+// Scalar forms of the lane functions, so that a kernel template can be
+// instantiated with float or double as well as with skSimd4f.
+
+static SK_INLINE float skSimdSelect(bool m, float a, float b)
+{
+    return m ? a : b;
+}
+
+static SK_INLINE double skSimdSelect(bool m, double a, double b)
+{
+    return m ? a : b;
+}
+
+static SK_INLINE SKint32 skSimdSelect(bool m, SKint32 a, SKint32 b)
+{
+    return m ? a : b;
+}
+
+static SK_INLINE float skSimdAbs(float a)
+{
+    return fabsf(a);
+}
+
+static SK_INLINE double skSimdAbs(double a)
+{
+    return fabs(a);
+}
+
+static SK_INLINE float skSimdMin(float a, float b)
+{
+    return a < b ? a : b;
+}
+
+static SK_INLINE double skSimdMin(double a, double b)
+{
+    return a < b ? a : b;
+}
+
+static SK_INLINE float skSimdMax(float a, float b)
+{
+    return a > b ? a : b;
+}
+
+static SK_INLINE double skSimdMax(double a, double b)
+{
+    return a > b ? a : b;
+}
+
+static SK_INLINE float skSimdSqrt(float a)
+{
+    return sqrtf(a);
+}
+
+static SK_INLINE double skSimdSqrt(double a)
+{
+    return sqrt(a);
+}
+
+static SK_INLINE SKint32 skSimdTrunc(float a)
+{
+    return (SKint32)a;
+}
+
+static SK_INLINE float skSimdToFloat(SKint32 a)
+{
+    return (float)a;
+}
+
+static SK_INLINE SKint32 skSimdAsInt(float a)
+{
+    SKint32 r;
+    memcpy(&r, &a, sizeof(r));
+    return r;
+}
+
+static SK_INLINE float skSimdAsFloat(SKint32 a)
+{
+    float r;
+    memcpy(&r, &a, sizeof(r));
+    return r;
+}
+
+static SK_INLINE float skSimdFloor(float a)
+{
+    return floorf(a);
+}
+
+static SK_INLINE double skSimdFloor(double a)
+{
+    return floor(a);
+}
+
+static SK_INLINE bool skSimdAny(bool m)
+{
+    return m;
+}
+
+static SK_INLINE int skSimdMask(bool m)
+{
+    return m ? 1 : 0;
+}
+
+#ifdef SK_SIMD_AVX2
+
+/// <summary>
+/// Eight float lanes in an AVX register, with the interface of skSimd4f.
+/// The functions follow the SSE2 forms operation for operation, so the
+/// kernels return the same results at either width.
+/// </summary>
+class skSimd8f
+{
+public:
+    __m256 v;
+
+    skSimd8f() = default;
+
+    SK_INLINE skSimd8f(__m256 r) :
+        v(r)
+    {
+    }
+
+    SK_INLINE explicit skSimd8f(float s) :
+        v(_mm256_set1_ps(s))
+    {
+    }
+
+    SK_INLINE static skSimd8f load(const float* p)
+    {
+        return _mm256_loadu_ps(p);
+    }
+
+    SK_INLINE void store(float* p) const
+    {
+        _mm256_storeu_ps(p, v);
+    }
+
+    SK_INLINE skSimd8f operator+(const skSimd8f& r) const { return _mm256_add_ps(v, r.v); }
+    SK_INLINE skSimd8f operator-(const skSimd8f& r) const { return _mm256_sub_ps(v, r.v); }
+    SK_INLINE skSimd8f operator*(const skSimd8f& r) const { return _mm256_mul_ps(v, r.v); }
+    SK_INLINE skSimd8f operator/(const skSimd8f& r) const { return _mm256_div_ps(v, r.v); }
+    SK_INLINE skSimd8f operator&(const skSimd8f& r) const { return _mm256_and_ps(v, r.v); }
+    SK_INLINE skSimd8f operator|(const skSimd8f& r) const { return _mm256_or_ps(v, r.v); }
+    SK_INLINE skSimd8f operator^(const skSimd8f& r) const { return _mm256_xor_ps(v, r.v); }
+    SK_INLINE skSimd8f operator<(const skSimd8f& r) const { return _mm256_cmp_ps(v, r.v, _CMP_LT_OQ); }
+    SK_INLINE skSimd8f operator<=(const skSimd8f& r) const { return _mm256_cmp_ps(v, r.v, _CMP_LE_OQ); }
+    SK_INLINE skSimd8f operator>(const skSimd8f& r) const { return _mm256_cmp_ps(v, r.v, _CMP_GT_OQ); }
+    SK_INLINE skSimd8f operator>=(const skSimd8f& r) const { return _mm256_cmp_ps(v, r.v, _CMP_GE_OQ); }
+    SK_INLINE skSimd8f operator==(const skSimd8f& r) const { return _mm256_cmp_ps(v, r.v, _CMP_EQ_OQ); }
+    SK_INLINE skSimd8f operator!=(const skSimd8f& r) const { return _mm256_cmp_ps(v, r.v, _CMP_NEQ_UQ); }
+
+    SK_INLINE skSimd8f operator-() const
+    {
+        return _mm256_xor_ps(v, _mm256_set1_ps(-0.f));
+    }
+};
+
+/// <summary>
+/// Eight 32 bit integer lanes, the integer companion of skSimd8f.
+/// </summary>
+class skSimd8i
+{
+public:
+    __m256i v;
+
+    skSimd8i() = default;
+
+    SK_INLINE skSimd8i(__m256i r) :
+        v(r)
+    {
+    }
+
+    SK_INLINE explicit skSimd8i(SKint32 s) :
+        v(_mm256_set1_epi32(s))
+    {
+    }
+
+    SK_INLINE skSimd8i operator+(const skSimd8i& r) const { return _mm256_add_epi32(v, r.v); }
+    SK_INLINE skSimd8i operator-(const skSimd8i& r) const { return _mm256_sub_epi32(v, r.v); }
+    SK_INLINE skSimd8i operator&(const skSimd8i& r) const { return _mm256_and_si256(v, r.v); }
+    SK_INLINE skSimd8i operator|(const skSimd8i& r) const { return _mm256_or_si256(v, r.v); }
+    SK_INLINE skSimd8i operator^(const skSimd8i& r) const { return _mm256_xor_si256(v, r.v); }
+    SK_INLINE skSimd8i operator==(const skSimd8i& r) const { return _mm256_cmpeq_epi32(v, r.v); }
+    SK_INLINE skSimd8i operator<<(int n) const { return _mm256_slli_epi32(v, n); }
+    SK_INLINE skSimd8i operator>>(int n) const { return _mm256_srai_epi32(v, n); }
+};
+
+static SK_INLINE skSimd8f skSimdMin(const skSimd8f& a, const skSimd8f& b)
+{
+    return _mm256_min_ps(a.v, b.v);
+}
+
+static SK_INLINE skSimd8f skSimdMax(const skSimd8f& a, const skSimd8f& b)
+{
+    return _mm256_max_ps(a.v, b.v);
+}
+
+static SK_INLINE skSimd8f skSimdSqrt(const skSimd8f& a)
+{
+    return _mm256_sqrt_ps(a.v);
+}
+
+static SK_INLINE skSimd8f skSimdRSqrtEst(const skSimd8f& a)
+{
+    return _mm256_rsqrt_ps(a.v);
+}
+
+static SK_INLINE skSimd8f skSimdSelect(const skSimd8f& mask, const skSimd8f& a, const skSimd8f& b)
+{
+    return _mm256_blendv_ps(b.v, a.v, mask.v);
+}
+
+static SK_INLINE skSimd8f skSimdSelect(const skSimd8i& mask, const skSimd8f& a, const skSimd8f& b)
+{
+    return _mm256_blendv_ps(b.v, a.v, _mm256_castsi256_ps(mask.v));
+}
+
+static SK_INLINE skSimd8i skSimdSelect(const skSimd8i& mask, const skSimd8i& a, const skSimd8i& b)
+{
+    return _mm256_blendv_epi8(b.v, a.v, mask.v);
+}
+
+static SK_INLINE skSimd8i skSimdTrunc(const skSimd8f& a)
+{
+    return _mm256_cvttps_epi32(a.v);
+}
+
+static SK_INLINE skSimd8f skSimdToFloat(const skSimd8i& a)
+{
+    return _mm256_cvtepi32_ps(a.v);
+}
+
+static SK_INLINE skSimd8i skSimdAsInt(const skSimd8f& a)
+{
+    return _mm256_castps_si256(a.v);
+}
+
+static SK_INLINE skSimd8f skSimdAsFloat(const skSimd8i& a)
+{
+    return _mm256_castsi256_ps(a.v);
+}
+
+static SK_INLINE bool skSimdAny(const skSimd8f& mask)
+{
+    return _mm256_movemask_ps(mask.v) != 0;
+}
+
+static SK_INLINE int skSimdMask(const skSimd8f& mask)
+{
+    return _mm256_movemask_ps(mask.v);
+}
+
+static SK_INLINE skSimd8f skSimdAbs(const skSimd8f& a)
+{
+    return skSimdAsFloat(skSimdAsInt(a) & skSimd8i(0x7FFFFFFF));
+}
+
+static SK_INLINE skSimd8f skSimdFloor(const skSimd8f& a)
+{
+    // As for skSimd4f, only lanes below 2^23 go through the truncation.
+    const skSimd8f t = skSimdToFloat(skSimdTrunc(a));
+    const skSimd8f f = skSimdSelect(t > a, t - skSimd8f(1.f), t);
+    return skSimdSelect(skSimdAbs(a) < skSimd8f(8388608.f), f, a);
+}
+
+#endif
+
+#ifdef SK_SIMD_AVX512
+
+/// <summary>
+/// One bit per lane of a skSimd16f or skSimd16i. AVX-512 comparisons
+/// write mask registers rather than lane masks.
+/// </summary>
+class skSimdMask16
+{
+public:
+    __mmask16 v;
+
+    skSimdMask16() = default;
+
+    SK_INLINE skSimdMask16(__mmask16 r) :
+        v(r)
+    {
+    }
+
+    SK_INLINE skSimdMask16 operator&(const skSimdMask16& r) const { return (__mmask16)(v & r.v); }
+    SK_INLINE skSimdMask16 operator|(const skSimdMask16& r) const { return (__mmask16)(v | r.v); }
+    SK_INLINE skSimdMask16 operator^(const skSimdMask16& r) const { return (__mmask16)(v ^ r.v); }
+};
+
+/// <summary>
+/// Sixteen float lanes in an AVX-512 register, with the interface of
+/// skSimd4f except that comparisons return a skSimdMask16.
+/// </summary>
+class skSimd16f
+{
+public:
+    __m512 v;
+
+    skSimd16f() = default;
+
+    SK_INLINE skSimd16f(__m512 r) :
+        v(r)
+    {
+    }
+
+    SK_INLINE explicit skSimd16f(float s) :
+        v(_mm512_set1_ps(s))
+    {
+    }
+
+    SK_INLINE static skSimd16f load(const float* p)
+    {
+        return _mm512_loadu_ps(p);
+    }
+
+    SK_INLINE void store(float* p) const
+    {
+        _mm512_storeu_ps(p, v);
+    }
+
+    SK_INLINE skSimd16f operator+(const skSimd16f& r) const { return _mm512_add_ps(v, r.v); }
+    SK_INLINE skSimd16f operator-(const skSimd16f& r) const { return _mm512_sub_ps(v, r.v); }
+    SK_INLINE skSimd16f operator*(const skSimd16f& r) const { return _mm512_mul_ps(v, r.v); }
+    SK_INLINE skSimd16f operator/(const skSimd16f& r) const { return _mm512_div_ps(v, r.v); }
+
+    SK_INLINE skSimdMask16 operator<(const skSimd16f& r) const { return _mm512_cmp_ps_mask(v, r.v, _CMP_LT_OQ); }
+    SK_INLINE skSimdMask16 operator<=(const skSimd16f& r) const { return _mm512_cmp_ps_mask(v, r.v, _CMP_LE_OQ); }
+    SK_INLINE skSimdMask16 operator>(const skSimd16f& r) const { return _mm512_cmp_ps_mask(v, r.v, _CMP_GT_OQ); }
+    SK_INLINE skSimdMask16 operator>=(const skSimd16f& r) const { return _mm512_cmp_ps_mask(v, r.v, _CMP_GE_OQ); }
+    SK_INLINE skSimdMask16 operator==(const skSimd16f& r) const { return _mm512_cmp_ps_mask(v, r.v, _CMP_EQ_OQ); }
+    SK_INLINE skSimdMask16 operator!=(const skSimd16f& r) const { return _mm512_cmp_ps_mask(v, r.v, _CMP_NEQ_UQ); }
+
+    SK_INLINE skSimd16f operator-() const
+    {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(v), _mm512_set1_epi32((int)0x80000000)));
+    }
+};
+
+/// <summary>
+/// Sixteen 32 bit integer lanes, the integer companion of skSimd16f.
+/// </summary>
+class skSimd16i
+{
+public:
+    __m512i v;
+
+    skSimd16i() = default;
+
+    SK_INLINE skSimd16i(__m512i r) :
+        v(r)
+    {
+    }
+
+    SK_INLINE explicit skSimd16i(SKint32 s) :
+        v(_mm512_set1_epi32(s))
+    {
+    }
+
+    SK_INLINE skSimd16i operator+(const skSimd16i& r) const { return _mm512_add_epi32(v, r.v); }
+    SK_INLINE skSimd16i operator-(const skSimd16i& r) const { return _mm512_sub_epi32(v, r.v); }
+    SK_INLINE skSimd16i operator&(const skSimd16i& r) const { return _mm512_and_si512(v, r.v); }
+    SK_INLINE skSimd16i operator|(const skSimd16i& r) const { return _mm512_or_si512(v, r.v); }
+    SK_INLINE skSimd16i operator^(const skSimd16i& r) const { return _mm512_xor_si512(v, r.v); }
+    SK_INLINE skSimdMask16 operator==(const skSimd16i& r) const { return _mm512_cmpeq_epi32_mask(v, r.v); }
+    SK_INLINE skSimd16i operator<<(int n) const { return _mm512_slli_epi32(v, (unsigned)n); }
+    SK_INLINE skSimd16i operator>>(int n) const { return _mm512_srai_epi32(v, (unsigned)n); }
+};
+
+static SK_INLINE skSimd16f skSimdMin(const skSimd16f& a, const skSimd16f& b)
+{
+    return _mm512_min_ps(a.v, b.v);
+}
+
+static SK_INLINE skSimd16f skSimdMax(const skSimd16f& a, const skSimd16f& b)
+{
+    return _mm512_max_ps(a.v, b.v);
+}
+
+static SK_INLINE skSimd16f skSimdSqrt(const skSimd16f& a)
+{
+    return _mm512_sqrt_ps(a.v);
+}
+
+/// <summary>
+/// Reciprocal square root estimate with 14 bits of precision, so unlike
+/// the other functions it does not match the narrower forms.
+/// </summary>
+static SK_INLINE skSimd16f skSimdRSqrtEst(const skSimd16f& a)
+{
+    return _mm512_rsqrt14_ps(a.v);
+}
+
+static SK_INLINE skSimd16f skSimdSelect(const skSimdMask16& mask, const skSimd16f& a, const skSimd16f& b)
+{
+    return _mm512_mask_blend_ps(mask.v, b.v, a.v);
+}
+
+static SK_INLINE skSimd16i skSimdSelect(const skSimdMask16& mask, const skSimd16i& a, const skSimd16i& b)
+{
+    return _mm512_mask_blend_epi32(mask.v, b.v, a.v);
+}
+
+static SK_INLINE skSimd16i skSimdTrunc(const skSimd16f& a)
+{
+    return _mm512_cvttps_epi32(a.v);
+}
+
+static SK_INLINE skSimd16f skSimdToFloat(const skSimd16i& a)
+{
+    return _mm512_cvtepi32_ps(a.v);
+}
+
+static SK_INLINE skSimd16i skSimdAsInt(const skSimd16f& a)
+{
+    return _mm512_castps_si512(a.v);
+}
+
+static SK_INLINE skSimd16f skSimdAsFloat(const skSimd16i& a)
+{
+    return _mm512_castsi512_ps(a.v);
+}
+
+static SK_INLINE bool skSimdAny(const skSimdMask16& mask)
+{
+    return mask.v != 0;
+}
+
+static SK_INLINE int skSimdMask(const skSimdMask16& mask)
+{
+    return (int)mask.v;
+}
+
+static SK_INLINE skSimd16f skSimdAbs(const skSimd16f& a)
+{
+    return skSimdAsFloat(skSimdAsInt(a) & skSimd16i(0x7FFFFFFF));
+}
+
+static SK_INLINE skSimd16f skSimdFloor(const skSimd16f& a)
+{
+    // As for skSimd4f, only lanes below 2^23 go through the truncation.
+    const skSimd16f t = skSimdToFloat(skSimdTrunc(a));
+    const skSimd16f f = skSimdSelect(t > a, t - skSimd16f(1.f), t);
+    return skSimdSelect(skSimdAbs(a) < skSimd16f(8388608.f), f, a);
+}
+
+#endif
+
+#endif  //_skSimd_h_
@@ -19,8 +19,26 @@
   3. This notice may not be removed or altered from any source distribution.
 -------------------------------------------------------------------------------
 */
+// Compiled with the AVX2 flags, see CMakeLists.txt. Only the lane
+// kernels may run here; anything else could be emitted with AVX2
+// instructions and end up called on a processor without them.
+#include "skSimdDispatch.h"
 
-#include "skTransform2D.h"
+#ifdef SK_SIMD_AVX2
 
-const skTransform2D skTransform2D::Identity = skTransform2D(1, 0, 0, 0, 1, 0, 0, 0, 1);
-const skTransform2D skTransform2D::Zero = skTransform2D(0, 0, 0, 0, 0, 0, 0, 0, 0);
+#include "skSimdKernels.inl"
+
+const skSimdDispatch::Kernels* skSimdDispatch::avx2Kernels()
+{
+    static const Kernels kernels = makeKernels<skSimd8f, skSimd8i>(AVX2);
+    return &kernels;
+}
+
+#else
+
+const skSimdDispatch::Kernels* skSimdDispatch::avx2Kernels()
+{
+    return nullptr;
+}
+
+#endif
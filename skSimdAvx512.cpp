@@ -0,0 +1,44 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+// Compiled with the AVX-512 flags, see CMakeLists.txt. Only the lane
+// kernels may run here; anything else could be emitted with AVX-512
+// instructions and end up called on a processor without them.
+#include "skSimdDispatch.h"
+
+#ifdef SK_SIMD_AVX512
+
+#include "skSimdKernels.inl"
+
+const skSimdDispatch::Kernels* skSimdDispatch::avx512Kernels()
+{
+    static const Kernels kernels = makeKernels<skSimd16f, skSimd16i>(AVX512);
+    return &kernels;
+}
+
+#else
+
+const skSimdDispatch::Kernels* skSimdDispatch::avx512Kernels()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,228 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skSimdDispatch.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include "skSimdKernels.inl"
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define SK_CPU_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+    std::atomic<const skSimdDispatch::Kernels*> Current{nullptr};
+
+#if defined(SK_CPU_X86) && defined(SK_SIMD_SSE2)
+    void cpuid(SKuint32 leaf, SKuint32 r[4])
+    {
+#ifdef _MSC_VER
+        int v[4];
+        __cpuidex(v, (int)leaf, 0);
+        for (int i = 0; i < 4; ++i)
+            r[i] = (SKuint32)v[i];
+#else
+        __cpuid_count(leaf, 0, r[0], r[1], r[2], r[3]);
+#endif
+    }
+
+    // The register state the operating system saves on a context switch.
+    SKuint64 xgetbv()
+    {
+#ifdef _MSC_VER
+        return _xgetbv(0);
+#else
+        SKuint32 lo, hi;
+        __asm__ __volatile__("xgetbv"
+                             : "=a"(lo), "=d"(hi)
+                             : "c"(0));
+        return ((SKuint64)hi << 32) | lo;
+#endif
+    }
+#endif
+
+    skSimdDispatch::Level cpuLevel()
+    {
+        skSimdDispatch::Level level = skSimdDispatch::Scalar;
+
+#if defined(SK_CPU_X86) && defined(SK_SIMD_SSE2)
+        SKuint32 r[4];
+        cpuid(0, r);
+        const SKuint32 maxLeaf = r[0];
+
+        cpuid(1, r);
+        if (!(r[3] & (1u << 26)))
+            return level;
+        level = skSimdDispatch::SSE2;
+
+        const bool osxsave = (r[2] & (1u << 27)) != 0;
+        const bool avx     = (r[2] & (1u << 28)) != 0;
+        if (!osxsave || !avx || maxLeaf < 7)
+            return level;
+
+        // XMM and YMM state, then the opmask and both halves of ZMM.
+        const SKuint64 xcr0 = xgetbv();
+        if ((xcr0 & 0x06) != 0x06)
+            return level;
+
+        cpuid(7, r);
+        if (!(r[1] & (1u << 5)))
+            return level;
+        level = skSimdDispatch::AVX2;
+
+        if ((xcr0 & 0xE6) == 0xE6 && (r[1] & (1u << 16)))
+            level = skSimdDispatch::AVX512;
+#endif
+        return level;
+    }
+
+    void merge(skSimdDispatch::Kernels& dst, const skSimdDispatch::Kernels& src)
+    {
+        dst.level = src.level;
+        if (src.wrap2Pi)
+            dst.wrap2Pi = src.wrap2Pi;
+        if (src.wrapPi)
+            dst.wrapPi = src.wrapPi;
+        if (src.sinCos)
+            dst.sinCos = src.sinCos;
+        if (src.atan2)
+            dst.atan2 = src.atan2;
+        if (src.add)
+            dst.add = src.add;
+        if (src.sub)
+            dst.sub = src.sub;
+        if (src.scale)
+            dst.scale = src.scale;
+        if (src.madd)
+            dst.madd = src.madd;
+        if (src.transform)
+            dst.transform = src.transform;
+        if (src.pointBounds)
+            dst.pointBounds = src.pointBounds;
+        if (src.boxBounds)
+            dst.boxBounds = src.boxBounds;
+        if (src.boxHit)
+            dst.boxHit = src.boxHit;
+        if (src.triangleBlock)
+            dst.triangleBlock = src.triangleBlock;
+    }
+
+    skSimdDispatch::Level parse(const char* str, skSimdDispatch::Level fallback)
+    {
+        for (int i = 0; i < skSimdDispatch::LevelCount; ++i)
+        {
+            const skSimdDispatch::Level level = (skSimdDispatch::Level)i;
+            if (strcmp(str, skSimdDispatch::name(level)) == 0)
+                return level;
+        }
+        return fallback;
+    }
+}  // namespace
+
+const skSimdDispatch::Kernels* skSimdDispatch::table(Level level)
+{
+    struct Tables
+    {
+        Kernels level[LevelCount];
+
+        Tables()
+        {
+            const Level cpu = cpuLevel();
+
+            level[Scalar] = makeKernels<float, SKint32>(Scalar);
+            for (int i = SSE2; i < LevelCount; ++i)
+            {
+                level[i] = level[i - 1];
+
+                const Kernels* k = nullptr;
+#ifdef SK_SIMD_SSE2
+                if (i == SSE2)
+                {
+                    static const Kernels sse2 = makeKernels<skSimd4f, skSimd4i>(SSE2);
+                    k                         = &sse2;
+                }
+#endif
+                if (i == AVX2 && cpu >= AVX2)
+                    k = avx2Kernels();
+                if (i == AVX512 && cpu >= AVX512)
+                    k = avx512Kernels();
+
+                if (k && i <= cpu)
+                    merge(level[i], *k);
+            }
+        }
+    };
+
+    static const Tables tables;
+    return &tables.level[level];
+}
+
+skSimdDispatch::Level skSimdDispatch::detect()
+{
+    return table(AVX512)->level;
+}
+
+void skSimdDispatch::setLevel(Level level)
+{
+    Current.store(table(level), std::memory_order_release);
+}
+
+const skSimdDispatch::Kernels& skSimdDispatch::kernels()
+{
+    const Kernels* k = Current.load(std::memory_order_acquire);
+    if (!k)
+    {
+        // Racing first calls all store the same table.
+        Level level = detect();
+
+        const char* env = getenv("SK_SIMD_LEVEL");
+        if (env)
+            level = parse(env, level);
+
+        k = table(level);
+        Current.store(k, std::memory_order_release);
+    }
+    return *k;
+}
+
+const char* skSimdDispatch::name(Level level)
+{
+    switch (level)
+    {
+    case Scalar:
+        return "scalar";
+    case SSE2:
+        return "sse2";
+    case AVX2:
+        return "avx2";
+    case AVX512:
+        return "avx512";
+    default:
+        return "unknown";
+    }
+}
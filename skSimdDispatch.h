@@ -0,0 +1,150 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSimdDispatch_h_
+#define _skSimdDispatch_h_
+
+#include "skSimd.h"
+
+/// <summary>
+/// Picks the widest SIMD kernels the processor supports, once, from
+/// CPUID. The SSE2 kernels are always built; the AVX2 and AVX-512 ones
+/// are compiled in their own translation units with the matching
+/// instruction set flags, so one binary runs everywhere and still uses
+/// the wider registers where they exist.
+///
+/// Every level computes the same operations in the same order without
+/// contraction into fused multiply-adds, so the kernels return identical
+/// results whichever level runs them.
+///
+/// The SK_SIMD_LEVEL environment variable, one of scalar, sse2, avx2 or
+/// avx512, caps the level picked at start up.
+/// </summary>
+class skSimdDispatch
+{
+public:
+    enum Level
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        AVX512,
+        LevelCount
+    };
+
+    /// <summary>
+    /// skTraversalRay in the form the box kernel takes.
+    /// </summary>
+    struct BoxRay
+    {
+        float    origin[3];
+        float    inverse[3];
+        SKuint32 sign[3];
+        float    tmin, tmax;
+    };
+
+    /// <summary>
+    /// The single precision batch kernels of one level. The stream kernels
+    /// process a prefix of their input, a whole number of lanes, and
+    /// return its length; the caller finishes the rest with the scalar
+    /// form. The AVX-512 kernels finish the tail themselves with masked
+    /// loads and stores, so they always return count.
+    /// </summary>
+    struct Kernels
+    {
+        Level level;
+
+        SKsize (*wrap2Pi)(float* dst, const float* src, SKsize count);
+        SKsize (*wrapPi)(float* dst, const float* src, SKsize count);
+        SKsize (*sinCos)(const float* theta, float* y, float* x, SKsize count);
+        SKsize (*atan2)(float* dst, const float* y, const float* x, SKsize count);
+
+        /// <summary>
+        /// Element wise over count floats, which covers arrays of packed
+        /// vectors. madd computes dst = a + b * s.
+        /// </summary>
+        SKsize (*add)(float* dst, const float* a, const float* b, SKsize count);
+        SKsize (*sub)(float* dst, const float* a, const float* b, SKsize count);
+        SKsize (*scale)(float* dst, const float* a, float s, SKsize count);
+        SKsize (*madd)(float* dst, const float* a, const float* b, float s, SKsize count);
+
+        /// <summary>
+        /// Transforms count packed points by the top three rows of a row
+        /// major 4x4 matrix, twelve floats, treating them as w = 1.
+        /// </summary>
+        SKsize (*transform)(float* dst, const float* m, const float* src, SKsize count);
+
+        /// <summary>
+        /// Grows box, six floats laid out as skBoundingBox3D, to enclose
+        /// count packed points or count packed boxes.
+        /// </summary>
+        SKsize (*pointBounds)(float* box, const float* points, SKsize count);
+        SKsize (*boxBounds)(float* box, const float* boxes, SKsize count);
+
+        /// <summary>
+        /// Tests boxes, six floats each, from index i on, and advances i
+        /// past the boxes it tested. Returns the number of hits written.
+        /// </summary>
+        SKsize (*boxHit)(SKuint32* hits, float* t, SKsize& i, const BoxRay& ray, const float* boxes, SKsize count);
+
+        /// <summary>
+        /// Writes the hit distance of each lane of a skTriangleBlock, or
+        /// SK_INFINITY for a miss. ray holds the origin and the direction.
+        /// </summary>
+        void (*triangleBlock)(float* t, const float* block, const float* ray, float lo, float hi);
+    };
+
+    /// <summary>
+    /// The widest level that both the processor and the operating system
+    /// support and that this build has kernels for.
+    /// </summary>
+    static Level detect();
+
+    static Level level()
+    {
+        return kernels().level;
+    }
+
+    /// <summary>
+    /// Switches to level, or to the widest supported level below it.
+    /// Meant for tests and benchmarks. Kernels already running on other
+    /// threads finish at the previous level.
+    /// </summary>
+    static void setLevel(Level level);
+
+    static const Kernels& kernels();
+
+    static const char* name(Level level);
+
+private:
+    // The table for level, built on first use. Entries a level does not
+    // provide come from the level below.
+    static const Kernels* table(Level level);
+
+    // Defined in skSimdAvx2.cpp and skSimdAvx512.cpp. Null when the
+    // compiler was not asked to target the instruction set. They run
+    // code compiled for it, so they are only called once CPUID has
+    // reported support.
+    static const Kernels* avx2Kernels();
+    static const Kernels* avx512Kernels();
+};
+
+#endif  //_skSimdDispatch_h_
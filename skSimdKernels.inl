@@ -0,0 +1,910 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSimdKernels_inl_
+#define _skSimdKernels_inl_
+
+// Lane kernels shared by the translation units that build a level of
+// skSimdDispatch. Each is a template over the lane type, instantiated
+// with float/SKint32 for the scalar form and with skSimd4f/skSimd4i,
+// skSimd8f/skSimd8i or skSimd16f/skSimd16i in the unit compiled for that
+// instruction set. Everything here has internal linkage, so the copies
+// compiled with different flags never merge at link time. For the same
+// reason the wider units must not call the inline functions of the
+// other headers, which would be emitted with the wider instructions.
+//
+// The skFastMath coefficients are the minimax polynomials from the
+// Cephes single precision library.
+#include <cfloat>
+#include <cmath>
+#include <utility>
+#include "skMath.h"
+#include "skSimd.h"
+#include "skSimdDispatch.h"
+
+// Marks the step a batch passes to forLanes. The masked 16 wide steps
+// are called twice, for the full registers and the tail, and GCC would
+// otherwise keep them out of line for their stack frame size.
+#if defined(__GNUC__) || defined(__clang__)
+#define SK_SIMD_STEP __attribute__((always_inline))
+#else
+#define SK_SIMD_STEP
+#endif
+
+namespace
+{
+    // Loads and stores of one register. The forms taking n touch only
+    // the first n lanes when Masked is set; otherwise n is always Width.
+    template <typename F>
+    struct Lanes
+    {
+        static constexpr SKsize Width  = sizeof(F) / sizeof(float);
+        static constexpr bool   Masked = false;
+
+        SK_INLINE static F load(const float* p)
+        {
+            return F::load(p);
+        }
+
+        SK_INLINE static F load(const float* p, SKsize)
+        {
+            return F::load(p);
+        }
+
+        SK_INLINE static F load(const float* p, SKsize, const F&)
+        {
+            return F::load(p);
+        }
+
+        SK_INLINE static void store(const F& v, float* p)
+        {
+            v.store(p);
+        }
+
+        SK_INLINE static void store(const F& v, float* p, SKsize)
+        {
+            v.store(p);
+        }
+    };
+
+    template <>
+    struct Lanes<float>
+    {
+        static constexpr SKsize Width  = 1;
+        static constexpr bool   Masked = false;
+
+        SK_INLINE static float load(const float* p)
+        {
+            return *p;
+        }
+
+        SK_INLINE static float load(const float* p, SKsize)
+        {
+            return *p;
+        }
+
+        SK_INLINE static float load(const float* p, SKsize, float)
+        {
+            return *p;
+        }
+
+        SK_INLINE static void store(float v, float* p)
+        {
+            *p = v;
+        }
+
+        SK_INLINE static void store(float v, float* p, SKsize)
+        {
+            *p = v;
+        }
+    };
+
+#ifdef SK_SIMD_AVX512
+    template <>
+    struct Lanes<skSimd16f>
+    {
+        static constexpr SKsize Width  = 16;
+        static constexpr bool   Masked = true;
+
+        SK_INLINE static __mmask16 mask(SKsize n)
+        {
+            return n >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << n) - 1);
+        }
+
+        SK_INLINE static skSimd16f load(const float* p)
+        {
+            return _mm512_loadu_ps(p);
+        }
+
+        SK_INLINE static skSimd16f load(const float* p, SKsize n)
+        {
+            return _mm512_maskz_loadu_ps(mask(n), p);
+        }
+
+        // Lanes past n keep the value of fill.
+        SK_INLINE static skSimd16f load(const float* p, SKsize n, const skSimd16f& fill)
+        {
+            return _mm512_mask_loadu_ps(fill.v, mask(n), p);
+        }
+
+        SK_INLINE static void store(const skSimd16f& v, float* p)
+        {
+            _mm512_storeu_ps(p, v.v);
+        }
+
+        SK_INLINE static void store(const skSimd16f& v, float* p, SKsize n)
+        {
+            _mm512_mask_storeu_ps(p, mask(n), v.v);
+        }
+    };
+#endif
+
+    // Calls body(i, n) over [0, count) for n = Width lanes at a time and
+    // returns the length covered. Types with masked loads and stores
+    // finish the tail in one more call with n < Width; the others leave
+    // it to the caller.
+    template <typename F, typename Body>
+    SK_INLINE SKsize forLanes(SKsize count, Body&& body)
+    {
+        const SKsize w = Lanes<F>::Width;
+
+        SKsize i = 0;
+        for (; i + w <= count; i += w)
+            body(i, w);
+
+        if constexpr (Lanes<F>::Masked)
+        {
+            if (i < count)
+            {
+                body(i, count - i);
+                i = count;
+            }
+        }
+        return i;
+    }
+
+    template <typename Fn, SKsize... J>
+    SK_INLINE void unrolled(Fn&& fn, std::index_sequence<J...>)
+    {
+        (fn(J), ...);
+    }
+
+    // Calls fn(j) for j = 0 to N - 1, unrolled.
+    template <SKsize N, typename Fn>
+    SK_INLINE void unrolled(Fn&& fn)
+    {
+        unrolled(fn, std::make_index_sequence<N>());
+    }
+
+    // Splits n packed points, Width unless the type is masked, into one
+    // register per component.
+    template <typename F>
+    SK_INLINE void loadXYZ(const float* p, SKsize, F v[3])
+    {
+        float t[3][Lanes<F>::Width];
+        for (SKsize l = 0; l < Lanes<F>::Width; ++l)
+        {
+            for (SKsize k = 0; k < 3; ++k)
+                t[k][l] = p[3 * l + k];
+        }
+        for (SKsize k = 0; k < 3; ++k)
+            v[k] = Lanes<F>::load(t[k]);
+    }
+
+    template <typename F>
+    SK_INLINE void storeXYZ(const F v[3], float* p, SKsize)
+    {
+        float t[3][Lanes<F>::Width];
+        for (SKsize k = 0; k < 3; ++k)
+            Lanes<F>::store(v[k], t[k]);
+
+        for (SKsize l = 0; l < Lanes<F>::Width; ++l)
+        {
+            for (SKsize k = 0; k < 3; ++k)
+                p[3 * l + k] = t[k][l];
+        }
+    }
+
+#ifdef SK_SIMD_SSE2
+    // Lanes u[A], u[B], v[C], v[D].
+    template <int A, int B, int C, int D>
+    SK_INLINE __m128 shuffleLanes(__m128 u, __m128 v)
+    {
+        return _mm_shuffle_ps(u, v, _MM_SHUFFLE(D, C, B, A));
+    }
+#endif
+
+#ifdef SK_SIMD_AVX2
+    // The same within each 128 bit half.
+    template <int A, int B, int C, int D>
+    SK_INLINE __m256 shuffleLanes(__m256 u, __m256 v)
+    {
+        return _mm256_shuffle_ps(u, v, _MM_SHUFFLE(D, C, B, A));
+    }
+#endif
+
+#ifdef SK_SIMD_SSE2
+    // Four packed points in three registers, a = x0 y0 z0 x1,
+    // b = y1 z1 x2 y2 and c = z2 x3 y3 z3, to one register per component
+    // in five shuffles.
+    template <typename V>
+    SK_INLINE void splitPoints(V a, V b, V c, V& x, V& y, V& z)
+    {
+        const V ab = shuffleLanes<1, 2, 0, 1>(a, b);  // y0 z0 y1 z1
+        const V bc = shuffleLanes<2, 3, 1, 2>(b, c);  // x2 y2 x3 y3
+
+        x = shuffleLanes<0, 3, 0, 2>(a, bc);
+        y = shuffleLanes<0, 2, 1, 3>(ab, bc);
+        z = shuffleLanes<1, 3, 0, 3>(ab, c);
+    }
+
+    // The inverse of splitPoints, in six shuffles.
+    template <typename V>
+    SK_INLINE void joinPoints(V x, V y, V z, V& a, V& b, V& c)
+    {
+        const V xy = shuffleLanes<0, 2, 0, 2>(x, y);  // x0 x2 y0 y2
+        const V yz = shuffleLanes<1, 3, 1, 3>(y, z);  // y1 y3 z1 z3
+        const V zx = shuffleLanes<0, 2, 1, 3>(z, x);  // z0 z2 x1 x3
+
+        a = shuffleLanes<0, 2, 0, 2>(xy, zx);
+        b = shuffleLanes<0, 2, 1, 3>(yz, xy);
+        c = shuffleLanes<1, 3, 1, 3>(zx, yz);
+    }
+#endif
+
+    template <>
+    SK_INLINE void loadXYZ<float>(const float* p, SKsize, float v[3])
+    {
+        v[0] = p[0];
+        v[1] = p[1];
+        v[2] = p[2];
+    }
+
+    template <>
+    SK_INLINE void storeXYZ<float>(const float v[3], float* p, SKsize)
+    {
+        p[0] = v[0];
+        p[1] = v[1];
+        p[2] = v[2];
+    }
+
+#ifdef SK_SIMD_SSE2
+    template <>
+    SK_INLINE void loadXYZ<skSimd4f>(const float* p, SKsize, skSimd4f v[3])
+    {
+        __m128 x, y, z;
+        splitPoints(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), x, y, z);
+        v[0] = x;
+        v[1] = y;
+        v[2] = z;
+    }
+
+    template <>
+    SK_INLINE void storeXYZ<skSimd4f>(const skSimd4f v[3], float* p, SKsize)
+    {
+        __m128 a, b, c;
+        joinPoints(v[0].v, v[1].v, v[2].v, a, b, c);
+        _mm_storeu_ps(p, a);
+        _mm_storeu_ps(p + 4, b);
+        _mm_storeu_ps(p + 8, c);
+    }
+#endif
+
+#ifdef SK_SIMD_AVX2
+    // Points 0 to 3 go to the low halves and points 4 to 7 to the high.
+    template <>
+    SK_INLINE void loadXYZ<skSimd8f>(const float* p, SKsize, skSimd8f v[3])
+    {
+        const __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+        const __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+        const __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+
+        __m256 x, y, z;
+        splitPoints(a, b, c, x, y, z);
+        v[0] = x;
+        v[1] = y;
+        v[2] = z;
+    }
+
+    template <>
+    SK_INLINE void storeXYZ<skSimd8f>(const skSimd8f v[3], float* p, SKsize)
+    {
+        __m256 a, b, c;
+        joinPoints(v[0].v, v[1].v, v[2].v, a, b, c);
+        _mm_storeu_ps(p, _mm256_castps256_ps128(a));
+        _mm_storeu_ps(p + 4, _mm256_castps256_ps128(b));
+        _mm_storeu_ps(p + 8, _mm256_castps256_ps128(c));
+        _mm_storeu_ps(p + 12, _mm256_extractf128_ps(a, 1));
+        _mm_storeu_ps(p + 16, _mm256_extractf128_ps(b, 1));
+        _mm_storeu_ps(p + 20, _mm256_extractf128_ps(c, 1));
+    }
+#endif
+
+#ifdef SK_SIMD_AVX512
+    // Permutations between three registers holding sixteen packed points
+    // and one register per component, for _mm512_permutex2var_ps. Each
+    // direction takes two passes, the first over two of the three
+    // registers and the second filling the remaining lanes from the third.
+    struct PointIndex
+    {
+        SKint32 split[3][2][16];
+        SKint32 join[3][2][16];
+
+        constexpr PointIndex() :
+            split(),
+            join()
+        {
+            for (SKint32 k = 0; k < 3; ++k)
+            {
+                for (SKint32 l = 0; l < 16; ++l)
+                {
+                    // Float q holds component k of point l.
+                    const SKint32 q = 3 * l + k;
+
+                    split[k][0][l] = q < 32 ? q : 0;
+                    split[k][1][l] = q < 32 ? l : q - 16;
+
+                    // Lane l of output register k holds component c of point p.
+                    const SKint32 p = (16 * k + l) / 3;
+                    const SKint32 c = (16 * k + l) % 3;
+
+                    join[k][0][l] = c == 0 ? p : 16 + p;
+                    join[k][1][l] = c == 2 ? 16 + p : l;
+                }
+            }
+        }
+    };
+
+    constexpr PointIndex Points;
+
+    template <>
+    SK_INLINE void loadXYZ<skSimd16f>(const float* p, SKsize n, skSimd16f v[3])
+    {
+        const SKsize f = 3 * n;
+
+        __m512 r[3];
+        unrolled<3>([&](SKsize j) {
+            r[j] = _mm512_maskz_loadu_ps(Lanes<skSimd16f>::mask(f > 16 * j ? f - 16 * j : 0), p + 16 * j);
+        });
+
+        unrolled<3>([&](SKsize k) {
+            const __m512 t = _mm512_permutex2var_ps(r[0], _mm512_loadu_si512(Points.split[k][0]), r[1]);
+            v[k]           = _mm512_permutex2var_ps(t, _mm512_loadu_si512(Points.split[k][1]), r[2]);
+        });
+    }
+
+    template <>
+    SK_INLINE void storeXYZ<skSimd16f>(const skSimd16f v[3], float* p, SKsize n)
+    {
+        const SKsize f = 3 * n;
+
+        unrolled<3>([&](SKsize j) {
+            const __m512 t = _mm512_permutex2var_ps(v[0].v, _mm512_loadu_si512(Points.join[j][0]), v[1].v);
+            const __m512 r = _mm512_permutex2var_ps(t, _mm512_loadu_si512(Points.join[j][1]), v[2].v);
+            _mm512_mask_storeu_ps(p + 16 * j, Lanes<skSimd16f>::mask(f > 16 * j ? f - 16 * j : 0), r);
+        });
+    }
+#endif
+
+    // Lane l of the result is p[l * stride].
+    template <typename F>
+    SK_INLINE F gather(const float* p, SKsize stride)
+    {
+        float t[Lanes<F>::Width];
+        for (SKsize l = 0; l < Lanes<F>::Width; ++l)
+            t[l] = p[l * stride];
+        return Lanes<F>::load(t);
+    }
+
+#ifdef SK_SIMD_AVX2
+    template <>
+    SK_INLINE skSimd8f gather<skSimd8f>(const float* p, SKsize stride)
+    {
+        const __m256i i = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int)stride));
+        return _mm256_i32gather_ps(p, i, 4);
+    }
+#endif
+
+#ifdef SK_SIMD_AVX512
+    template <>
+    SK_INLINE skSimd16f gather<skSimd16f>(const float* p, SKsize stride)
+    {
+        const __m512i i = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32((int)stride));
+        return _mm512_i32gather_ps(i, p, 4);
+    }
+#endif
+
+    const float SinCosLimit = 8192.f;
+
+    template <typename F, typename I>
+    SK_INLINE void sinCosKernel(const F& x, F& s, F& c)
+    {
+        // Reduce to z in [-pi/4, pi/4] with j the even octant. pi/4 is split
+        // into parts of at most ten significant bits so that every product
+        // with j is exact over the domain.
+        const F ax = skSimdAbs(x);
+
+        I j = skSimdTrunc(skSimdMin(ax, F(SinCosLimit)) * F(1.27323954473516f));
+        j   = (j + I(1)) & I(~1);
+
+        const F y  = skSimdToFloat(j);
+        const F z  = (((ax - y * F(0.78515625f)) - y * F(2.4199485778808594e-4f)) - y * F(-8.149072527885437e-8f)) - y * F(3.038550314138355e-11f);
+        const F zz = z * z;
+
+        const F pc = ((F(2.443315711809948e-5f) * zz - F(1.388731625493765e-3f)) * zz + F(4.166664568298827e-2f)) * zz * zz - F(0.5f) * zz + F(1.f);
+        const F ps = ((F(-1.9515295891e-4f) * zz + F(8.3321608736e-3f)) * zz - F(1.6666654611e-1f)) * zz * z + z;
+
+        const auto swap = (j & I(2)) == I(2);
+
+        F sv = skSimdSelect(swap, pc, ps);
+        F cv = skSimdSelect(swap, ps, pc);
+
+        sv = skSimdSelect((j & I(4)) == I(4), -sv, sv);
+        cv = skSimdSelect(((j + I(2)) & I(4)) == I(4), -cv, cv);
+
+        s = skSimdSelect(x < F(0.f), -sv, sv);
+        c = cv;
+    }
+
+    template <typename F, typename I>
+    SK_INLINE F atan2Kernel(const F& y, const F& x)
+    {
+        // atan of t = min/max in [0, 1], then unfold the octant.
+        const F ax = skSimdAbs(x);
+        const F ay = skSimdAbs(y);
+        const F mx = skSimdMax(ax, ay);
+        const F mn = skSimdMin(ax, ay);
+
+        F t = skSimdSelect(mx == F(0.f), F(0.f), mn / mx);
+
+        const auto big = t > F(0.4142135623730950f);
+
+        t         = skSimdSelect(big, (t - F(1.f)) / (t + F(1.f)), t);
+        const F z = t * t;
+
+        F r = (((F(8.05374449538e-2f) * z - F(1.38776856032e-1f)) * z + F(1.99777106478e-1f)) * z - F(3.33329491539e-1f)) * z * t + t;
+        r   = r + skSimdSelect(big, F(0.78539816339744830962f), F(0.f));
+
+        r = skSimdSelect(ay > ax, F(1.57079632679489661923f) - r, r);
+        r = skSimdSelect((skSimdAsInt(x) >> 31) == I(-1), F(3.14159265358979323846f) - r, r);
+        return skSimdSelect((skSimdAsInt(y) >> 31) == I(-1), -r, r);
+    }
+
+    template <typename F, typename I>
+    SK_INLINE F expKernel(const F& x)
+    {
+        // exp(x) = 2^n * exp(r), with r = x - n ln2 in [-ln2/2, ln2/2].
+        const float hi = 88.72283935546875f;
+        const float lo = -103.972084f;
+
+        const F xc = skSimdMin(skSimdMax(x, F(lo)), F(hi));
+        const F fx = xc * F(1.44269504088896341f) + F(0.5f);
+
+        F fn = skSimdToFloat(skSimdTrunc(fx));
+        fn   = skSimdSelect(fn > fx, fn - F(1.f), fn);
+
+        const F r = xc - fn * F(0.693359375f) + fn * F(2.12194440e-4f);
+        const F z = r * r;
+
+        const F p = (((((F(1.9875691500e-4f) * r + F(1.3981999507e-3f)) * r + F(8.3334519073e-3f)) * r + F(4.1665795894e-2f)) * r + F(1.6666665459e-1f)) * r + F(5.0000001201e-1f)) * z + r + F(1.f);
+
+        // Scale in two halves so that both stay normal over [lo, hi].
+        const I n  = skSimdTrunc(fn);
+        const I h  = n >> 1;
+        const F s1 = skSimdAsFloat((h + I(127)) << 23);
+        const F s2 = skSimdAsFloat((n - h + I(127)) << 23);
+
+        F res = p * s1 * s2;
+        res   = skSimdSelect(x > F(hi), F(INFINITY), res);
+        res   = skSimdSelect(x < F(lo), F(0.f), res);
+        return skSimdSelect(x != x, x, res);
+    }
+
+    template <typename F, typename I>
+    SK_INLINE F logKernel(const F& x)
+    {
+        // log(x) = e ln2 + log(m), with m in [sqrt(1/2), sqrt(2)).
+        const auto small = x < F(FLT_MIN);
+
+        const F xs   = skSimdSelect(small, x * F(8388608.f), x);
+        const I bits = skSimdAsInt(xs);
+
+        F fe = skSimdToFloat((bits >> 23) - I(126));
+        fe   = fe - skSimdSelect(small, F(23.f), F(0.f));
+
+        const F m  = skSimdAsFloat((bits & I(0x007FFFFF)) | I(0x3F000000));
+        const auto lt = m < F(0.707106781186547524f);
+
+        fe        = skSimdSelect(lt, fe - F(1.f), fe);
+        const F t = skSimdSelect(lt, m + m - F(1.f), m - F(1.f));
+        const F z = t * t;
+
+        F y = ((((((((F(7.0376836292e-2f) * t - F(1.1514610310e-1f)) * t + F(1.1676998740e-1f)) * t - F(1.2420140846e-1f)) * t + F(1.4249322787e-1f)) * t - F(1.6668057665e-1f)) * t + F(2.0000714765e-1f)) * t - F(2.4999993993e-1f)) * t + F(3.3333331174e-1f)) * t * z;
+
+        y = y - fe * F(2.12194440e-4f) - F(0.5f) * z;
+
+        F r = t + y + fe * F(0.693359375f);
+        r   = skSimdSelect(x == F(INFINITY), x, r);
+        r   = skSimdSelect(x == F(0.f), F(-INFINITY), r);
+        r   = skSimdSelect(x < F(0.f), F(NAN), r);
+        return skSimdSelect(x != x, x, r);
+    }
+
+    template <typename F>
+    struct RayLanes
+    {
+        F o[3];
+        F inv[3];
+        F tmin, tmax;
+    };
+
+    // Entry distance test, with front and back the box planes picked by
+    // the ray signs. A ray in the plane of a slab computes 0 * inf, a
+    // NaN, and min and max return their second argument on a NaN, so
+    // that slab is skipped.
+    template <typename F>
+    SK_INLINE auto entry(F& tn, const RayLanes<F>& r, const F* front, const F* back)
+    {
+        F tf = r.tmax;
+
+        tn = r.tmin;
+        for (int k = 0; k < 3; ++k)
+        {
+            tn = skSimdMax((front[k] - r.o[k]) * r.inv[k], tn);
+            tf = skSimdMin((back[k] - r.o[k]) * r.inv[k], tf);
+        }
+        return tn <= tf;
+    }
+
+    // Layout of skTriangleBlock: the corner and the two edges, each as
+    // three rows of BlockWidth lanes.
+    const SKsize BlockWidth = 8;
+    const SKsize BlockE1    = 3 * BlockWidth;
+    const SKsize BlockE2    = 6 * BlockWidth;
+
+    // Moller-Trumbore across the lanes l to l + Width of a block.
+    template <typename F>
+    SK_INLINE F triangleLanes(const float* b, SKsize l, const F* o, const F* d, const F& lo, const F& hi)
+    {
+        typedef Lanes<F> L;
+
+        F s[3], e1[3], e2[3];
+        for (SKsize i = 0; i < 3; ++i)
+        {
+            s[i]  = o[i] - L::load(b + i * BlockWidth + l);
+            e1[i] = L::load(b + BlockE1 + i * BlockWidth + l);
+            e2[i] = L::load(b + BlockE2 + i * BlockWidth + l);
+        }
+
+        const F p0 = d[1] * e2[2] - d[2] * e2[1];
+        const F p1 = d[2] * e2[0] - d[0] * e2[2];
+        const F p2 = d[0] * e2[1] - d[1] * e2[0];
+
+        const F det = e1[0] * p0 + e1[1] * p1 + e1[2] * p2;
+        const F inv = F(1.f) / det;
+
+        const F q0 = s[1] * e1[2] - s[2] * e1[1];
+        const F q1 = s[2] * e1[0] - s[0] * e1[2];
+        const F q2 = s[0] * e1[1] - s[1] * e1[0];
+
+        const F u = (s[0] * p0 + s[1] * p1 + s[2] * p2) * inv;
+        const F v = (d[0] * q0 + d[1] * q1 + d[2] * q2) * inv;
+        const F t = (e2[0] * q0 + e2[1] * q1 + e2[2] * q2) * inv;
+
+        const F zero(0.f);
+
+        const auto mask = (det != zero) &
+                          (u >= zero) &
+                          (v >= zero) &
+                          (u + v <= F(1.f)) &
+                          (t >= lo) &
+                          (t <= hi);
+
+        return skSimdSelect(mask, t, F(FLT_MAX));
+    }
+
+    template <typename F>
+    SKsize wrap2PiBatch(float* dst, const float* src, SKsize count)
+    {
+        typedef Lanes<F> L;
+
+        const F two(2.f), ip2((float)skInvPi2), pi((float)skPi);
+
+        return forLanes<F>(count, [&](SKsize i, SKsize n) SK_SIMD_STEP {
+            const F v = L::load(src + i, n);
+            L::store(v - two * skSimdFloor(v * ip2) * pi, dst + i, n);
+        });
+    }
+
+    template <typename F>
+    SKsize wrapPiBatch(float* dst, const float* src, SKsize count)
+    {
+        typedef Lanes<F> L;
+
+        const F two(2.f), half(0.5f), ip2((float)skInvPi2), pi((float)skPi);
+
+        return forLanes<F>(count, [&](SKsize i, SKsize n) SK_SIMD_STEP {
+            const F v = L::load(src + i, n);
+            L::store(v - two * skSimdFloor(v * ip2 + half) * pi, dst + i, n);
+        });
+    }
+
+    template <typename F, typename I>
+    SKsize sinCosBatch(const float* theta, float* y, float* x, SKsize count)
+    {
+        typedef Lanes<F> L;
+
+        return forLanes<F>(count, [&](SKsize i, SKsize n) SK_SIMD_STEP {
+            const F v = L::load(theta + i, n);
+
+            F s, c;
+            sinCosKernel<F, I>(v, s, c);
+
+            // Lanes past the reduction range fall back to libm. The fix
+            // up works on copies, since y or x may alias theta.
+            if (skSimdAny(skSimdAbs(v) > F(SinCosLimit)))
+            {
+                float xv[L::Width], sv[L::Width], cv[L::Width];
+                L::store(v, xv);
+                L::store(s, sv);
+                L::store(c, cv);
+
+                for (SKsize l = 0; l < L::Width; ++l)
+                {
+                    if (fabsf(xv[l]) > SinCosLimit)
+                    {
+                        sv[l] = sinf(xv[l]);
+                        cv[l] = cosf(xv[l]);
+                    }
+                }
+                s = L::load(sv);
+                c = L::load(cv);
+            }
+
+            L::store(s, y + i, n);
+            L::store(c, x + i, n);
+        });
+    }
+
+    template <typename F, typename I>
+    SKsize atan2Batch(float* dst, const float* y, const float* x, SKsize count)
+    {
+        typedef Lanes<F> L;
+
+        return forLanes<F>(count, [&](SKsize i, SKsize n) SK_SIMD_STEP {
+            L::store(atan2Kernel<F, I>(L::load(y + i, n), L::load(x + i, n)), dst + i, n);
+        });
+    }
+
+    template <typename F>
+    SKsize addBatch(float* dst, const float* a, const float* b, SKsize count)
+    {
+        typedef Lanes<F> L;
+
+        return forLanes<F>(count, [&](SKsize i, SKsize n) SK_SIMD_STEP {
+            L::store(L::load(a + i, n) + L::load(b + i, n), dst + i, n);
+        });
+    }
+
+    template <typename F>
+    SKsize subBatch(float* dst, const float* a, const float* b, SKsize count)
+    {
+        typedef Lanes<F> L;
+
+        return forLanes<F>(count, [&](SKsize i, SKsize n) SK_SIMD_STEP {
+            L::store(L::load(a + i, n) - L::load(b + i, n), dst + i, n);
+        });
+    }
+
+    template <typename F>
+    SKsize scaleBatch(float* dst, const float* a, float s, SKsize count)
+    {
+        typedef Lanes<F> L;
+
+        const F fs(s);
+
+        return forLanes<F>(count, [&](SKsize i, SKsize n) SK_SIMD_STEP {
+            L::store(L::load(a + i, n) * fs, dst + i, n);
+        });
+    }
+
+    template <typename F>
+    SKsize maddBatch(float* dst, const float* a, const float* b, float s, SKsize count)
+    {
+        typedef Lanes<F> L;
+
+        const F fs(s);
+
+        return forLanes<F>(count, [&](SKsize i, SKsize n) SK_SIMD_STEP {
+            L::store(L::load(a + i, n) + L::load(b + i, n) * fs, dst + i, n);
+        });
+    }
+
+    template <typename F>
+    SKsize transformBatch(float* dst, const float* m, const float* src, SKsize count)
+    {
+        F r[12];
+        unrolled<12>([&](SKsize k) { r[k] = F(m[k]); });
+
+        // One lane per point.
+        return forLanes<F>(count, [&](SKsize i, SKsize n) SK_SIMD_STEP {
+            F p[3], o[3];
+            loadXYZ(src + 3 * i, n, p);
+
+            unrolled<3>([&](SKsize k) {
+                o[k] = r[4 * k] * p[0] + r[4 * k + 1] * p[1] + r[4 * k + 2] * p[2] + r[4 * k + 3];
+            });
+
+            storeXYZ(o, dst + 3 * i, n);
+        });
+    }
+
+    // Grows box, laid out as skBoundingBox3D, over count records of
+    // Stride floats. A record is a point when Stride is 3 and a box when
+    // it is 6. The records are read as flat registers, so float s of
+    // every record lands in a fixed set of lanes; each register keeps a
+    // minimum and a maximum and the lanes are folded into box at the end.
+    template <typename F, SKsize Stride>
+    SKsize boundsBatch(float* box, const float* records, SKsize count)
+    {
+        typedef Lanes<F> L;
+
+        F lo[Stride], hi[Stride];
+        unrolled<Stride>([&](SKsize j) {
+            lo[j] = F(INFINITY);
+            hi[j] = F(-INFINITY);
+        });
+
+        const SKsize done = forLanes<F>(count, [&](SKsize i, SKsize n) SK_SIMD_STEP {
+            const float* p    = records + Stride * i;
+            const SKsize rest = Stride * n;
+
+            unrolled<Stride>([&](SKsize j) {
+                // Lanes past the last record repeat the running bound.
+                const SKsize nj = rest > j * L::Width ? rest - j * L::Width : 0;
+
+                lo[j] = skSimdMin(L::load(p + j * L::Width, nj, lo[j]), lo[j]);
+                hi[j] = skSimdMax(L::load(p + j * L::Width, nj, hi[j]), hi[j]);
+            });
+        });
+
+        // Float s bounds component s % 3, from below when s < 3 and from
+        // above when s >= 3 or the record is a point.
+        float tl[Stride][L::Width], th[Stride][L::Width];
+        unrolled<Stride>([&](SKsize j) {
+            L::store(lo[j], tl[j]);
+            L::store(hi[j], th[j]);
+        });
+
+        SKsize s = 0;
+        for (SKsize j = 0; j < Stride; ++j)
+        {
+            for (SKsize l = 0; l < L::Width; ++l)
+            {
+                const SKsize c = s < 3 ? s : s - 3;
+                if (Stride == 3 || s < 3)
+                    box[c] = skSimdMin(tl[j][l], box[c]);
+                if (Stride == 3 || s >= 3)
+                    box[3 + c] = skSimdMax(th[j][l], box[3 + c]);
+
+                if (++s == Stride)
+                    s = 0;
+            }
+        }
+        return done;
+    }
+
+    template <typename F>
+    SKsize boxHitBatch(SKuint32*                       hits,
+                       float*                          t,
+                       SKsize&                         i,
+                       const skSimdDispatch::BoxRay&   ray,
+                       const float*                    boxes,
+                       SKsize                          count)
+    {
+        typedef Lanes<F> L;
+
+        RayLanes<F> r;
+        for (int k = 0; k < 3; ++k)
+        {
+            r.o[k]   = F(ray.origin[k]);
+            r.inv[k] = F(ray.inverse[k]);
+        }
+        r.tmin = F(ray.tmin);
+        r.tmax = F(ray.tmax);
+
+        SKsize n = 0;
+        for (; i + L::Width <= count; i += L::Width)
+        {
+            // One lane per box, one register per plane.
+            const float* box = boxes + i * 6;
+
+            F front[3], back[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                front[k] = gather<F>(box + 3 * ray.sign[k] + k, 6);
+                back[k]  = gather<F>(box + 3 * (1 - ray.sign[k]) + k, 6);
+            }
+
+            F tn;
+
+            const int mask = skSimdMask(entry(tn, r, front, back));
+            if (mask == 0)
+                continue;
+
+            float tl[L::Width];
+            L::store(tn, tl);
+            for (SKsize l = 0; l < L::Width; ++l)
+            {
+                if (mask & (1 << l))
+                {
+                    hits[n] = (SKuint32)(i + l);
+                    t[n++]  = tl[l];
+                }
+            }
+        }
+        return n;
+    }
+
+    template <typename F>
+    void triangleBlockBatch(float* t, const float* block, const float* ray, float lo, float hi)
+    {
+        typedef Lanes<F> L;
+
+        F o[3], d[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            o[i] = F(ray[i]);
+            d[i] = F(ray[3 + i]);
+        }
+
+        const F fl(lo), fh(hi);
+        for (SKsize l = 0; l < BlockWidth; l += L::Width)
+            L::store(triangleLanes(block, l, o, d, fl, fh), t + l);
+    }
+
+    template <typename F, typename I>
+    skSimdDispatch::Kernels makeKernels(skSimdDispatch::Level level)
+    {
+        skSimdDispatch::Kernels k;
+        k.level         = level;
+        k.wrap2Pi       = wrap2PiBatch<F>;
+        k.wrapPi        = wrapPiBatch<F>;
+        k.sinCos        = sinCosBatch<F, I>;
+        k.atan2         = atan2Batch<F, I>;
+        k.add           = addBatch<F>;
+        k.sub           = subBatch<F>;
+        k.scale         = scaleBatch<F>;
+        k.madd          = maddBatch<F>;
+        k.transform     = transformBatch<F>;
+        k.pointBounds   = boundsBatch<F, 3>;
+        k.boxBounds     = boundsBatch<F, 6>;
+        k.boxHit        = boxHitBatch<F>;
+        k.triangleBlock = nullptr;
+
+        // Wider lanes than a block leave it to the level below.
+        if constexpr (Lanes<F>::Width <= BlockWidth)
+            k.triangleBlock = triangleBlockBatch<F>;
+        return k;
+    }
+}  // namespace
+
+#endif  //_skSimdKernels_inl_
@@ -0,0 +1,99 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSpan_h_
+#define _skSpan_h_
+
+#include <type_traits>
+#include "Utils/Config/skConfig.h"
+
+/// <summary>
+/// A pointer and a count viewing a contiguous array it does not own,
+/// such as the scratch arrays skFrameArena hands out. A span of T
+/// converts to a span of const T.
+/// </summary>
+template <typename T>
+class skSpan
+{
+private:
+    T*     m_data;
+    SKsize m_size;
+
+public:
+    constexpr skSpan() :
+        m_data(nullptr),
+        m_size(0)
+    {
+    }
+
+    constexpr skSpan(T* data, SKsize size) :
+        m_data(data),
+        m_size(size)
+    {
+    }
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr skSpan(const skSpan<U>& s) :
+        m_data(s.data()),
+        m_size(s.size())
+    {
+    }
+
+    constexpr T* data() const
+    {
+        return m_data;
+    }
+
+    constexpr SKsize size() const
+    {
+        return m_size;
+    }
+
+    constexpr bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    constexpr T& operator[](SKsize i) const
+    {
+        return m_data[i];
+    }
+
+    constexpr T* begin() const
+    {
+        return m_data;
+    }
+
+    constexpr T* end() const
+    {
+        return m_data + m_size;
+    }
+
+    /// <summary>
+    /// The count elements from first on.
+    /// </summary>
+    constexpr skSpan subspan(SKsize first, SKsize count) const
+    {
+        return skSpan(m_data + first, count);
+    }
+};
+
+#endif  //_skSpan_h_
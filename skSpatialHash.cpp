@@ -0,0 +1,223 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skSpatialHash.h"
+#include <algorithm>
+#include "skParallel.h"
+
+namespace
+{
+    // Points per worker before threads pay off.
+    const SKsize Grain = 16384;
+
+    // The counting sort runs one pass per 11 bits of the bucket index.
+    const SKuint32 DigitBits = 11;
+    const SKuint32 Radix     = 1 << DigitBits;
+}  // namespace
+
+skSpatialHash::skSpatialHash() :
+    m_threads(0),
+    m_mask(0),
+    m_cellSize(1),
+    m_invCellSize(1)
+{
+    m_start.assign(2, 0);
+}
+
+void skSpatialHash::build(const skVector3* points, SKuint32 count, skScalar cellSize, SKuint32 bucketCount)
+{
+    m_cellSize    = cellSize;
+    m_invCellSize = skScalar(1) / cellSize;
+
+    if (bucketCount == 0)
+        bucketCount = count > 0 ? 2 * count : 1;
+
+    SKuint32 bits = 0;
+    while ((SKuint32(1) << bits) < bucketCount && bits < 31)
+        ++bits;
+    m_mask = (SKuint32(1) << bits) - 1;
+
+    const SKsize n = count;
+    m_keys.resize(n);
+    m_indices.resize(n);
+    m_points.resize(n);
+    m_scratch[0].resize(n);
+    m_scratch[1].resize(n);
+
+    skParallel::forChunks(
+        n,
+        Grain,
+        [&](SKsize, SKsize first, SKsize last) {
+            for (SKsize i = first; i < last; ++i)
+            {
+                m_keys[i]    = bucketOf(points[i]);
+                m_indices[i] = (SKuint32)i;
+            }
+        },
+        m_threads);
+
+    // Least significant digit first. Each worker counts its own chunk,
+    // then scatters into the slots reserved for it, which keeps every
+    // pass stable and the result independent of scheduling.
+    const SKsize chunks = skParallel::chunkCount(n, Grain, m_threads);
+
+    for (SKuint32 shift = 0; shift < bits; shift += DigitBits)
+    {
+        m_histogram.assign(chunks * Radix, 0);
+
+        skParallel::forChunks(
+            n,
+            Grain,
+            [&](SKsize chunk, SKsize first, SKsize last) {
+                SKuint32* h = m_histogram.data() + chunk * Radix;
+                for (SKsize i = first; i < last; ++i)
+                    ++h[(m_keys[i] >> shift) & (Radix - 1)];
+            },
+            m_threads);
+
+        SKuint32 offset = 0;
+        for (SKuint32 d = 0; d < Radix; ++d)
+        {
+            for (SKsize c = 0; c < chunks; ++c)
+            {
+                SKuint32&      h = m_histogram[c * Radix + d];
+                const SKuint32 t = h;
+                h                = offset;
+                offset += t;
+            }
+        }
+
+        skParallel::forChunks(
+            n,
+            Grain,
+            [&](SKsize chunk, SKsize first, SKsize last) {
+                SKuint32* h = m_histogram.data() + chunk * Radix;
+                for (SKsize i = first; i < last; ++i)
+                {
+                    const SKuint32 pos = h[(m_keys[i] >> shift) & (Radix - 1)]++;
+
+                    m_scratch[0][pos] = m_keys[i];
+                    m_scratch[1][pos] = m_indices[i];
+                }
+            },
+            m_threads);
+
+        m_keys.swap(m_scratch[0]);
+        m_indices.swap(m_scratch[1]);
+    }
+
+    // Bucket starts. Each position writes the starts of the buckets
+    // between its predecessor's key and its own, so the writes of the
+    // workers never meet.
+    const SKuint32 buckets = m_mask + 1;
+    m_start.resize(buckets + 1);
+
+    if (n == 0)
+        std::fill(m_start.begin(), m_start.end(), 0);
+
+    skParallel::forChunks(
+        n,
+        Grain,
+        [&](SKsize, SKsize first, SKsize last) {
+            for (SKsize k = first; k < last; ++k)
+            {
+                const SKuint32 key = m_keys[k];
+                if (k == 0 || m_keys[k - 1] != key)
+                {
+                    const SKuint32 b0 = k > 0 ? m_keys[k - 1] + 1 : 0;
+                    for (SKuint32 b = b0; b <= key; ++b)
+                        m_start[b] = (SKuint32)k;
+                }
+
+                m_points[k] = points[m_indices[k]];
+            }
+
+            if (last == n)
+            {
+                for (SKuint32 b = m_keys[n - 1] + 1; b <= buckets; ++b)
+                    m_start[b] = (SKuint32)n;
+            }
+        },
+        m_threads);
+}
+
+SKuint32 skSpatialHash::gatherBuckets(const skVector3&       center,
+                                      skScalar               radius,
+                                      SKuint32*              local,
+                                      std::vector<SKuint32>& spill) const
+{
+    const SKint32 x0 = cell(center.x - radius), x1 = cell(center.x + radius);
+    const SKint32 y0 = cell(center.y - radius), y1 = cell(center.y + radius);
+    const SKint32 z0 = cell(center.z - radius), z1 = cell(center.z + radius);
+
+    // The extents are taken in double, x1 - x0 itself can overflow, and
+    // the loops below step in SKint64 so that a range ending at the
+    // clamped limit still terminates.
+    const double cells = (double(x1) - double(x0) + 1) * (double(y1) - double(y0) + 1) * (double(z1) - double(z0) + 1);
+
+    // Wider than the table; every bucket can hold a match.
+    if (cells > double(m_mask))
+    {
+        spill.resize(m_mask + 1);
+        for (SKuint32 b = 0; b <= m_mask; ++b)
+            spill[b] = b;
+        return m_mask + 1;
+    }
+
+    SKuint32 n = 0;
+    if (cells <= 64)
+    {
+        for (SKint64 z = z0; z <= z1; ++z)
+        {
+            for (SKint64 y = y0; y <= y1; ++y)
+            {
+                for (SKint64 x = x0; x <= x1; ++x)
+                {
+                    const SKuint32 b = bucketOf((SKint32)x, (SKint32)y, (SKint32)z);
+
+                    SKuint32 i = 0;
+                    while (i < n && local[i] != b)
+                        ++i;
+                    if (i == n)
+                        local[n++] = b;
+                }
+            }
+        }
+        return n;
+    }
+
+    spill.reserve((SKsize)cells);
+    for (SKint64 z = z0; z <= z1; ++z)
+        for (SKint64 y = y0; y <= y1; ++y)
+            for (SKint64 x = x0; x <= x1; ++x)
+                spill.push_back(bucketOf((SKint32)x, (SKint32)y, (SKint32)z));
+
+    std::sort(spill.begin(), spill.end());
+    spill.erase(std::unique(spill.begin(), spill.end()), spill.end());
+    return (SKuint32)spill.size();
+}
+
+SKsize skSpatialHash::query(std::vector<SKuint32>& out, const skVector3& center, skScalar radius) const
+{
+    const SKsize before = out.size();
+    query(center, radius, [&out](SKuint32 index, skScalar) { out.push_back(index); });
+    return out.size() - before;
+}
@@ -0,0 +1,187 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSpatialHash_h_
+#define _skSpatialHash_h_
+
+#include <vector>
+#include "skVector3.h"
+
+/// <summary>
+/// Uniform grid over an unbounded space, with cells hashed into a power
+/// of two table of buckets. build() counting sorts the point indices by
+/// bucket, so the points of a bucket are contiguous in sortedIndices()
+/// and sortedPoints(). Distinct cells can share a bucket, so queries
+/// always test the distance.
+/// </summary>
+class skSpatialHash
+{
+public:
+    skSpatialHash();
+
+    /// <summary>
+    /// Limits the workers used by build. Zero uses every hardware thread.
+    /// </summary>
+    void setThreadCount(SKuint32 threads)
+    {
+        m_threads = threads;
+    }
+
+    /// <summary>
+    /// Sorts count points into cells of edge cellSize. The bucket table
+    /// holds bucketCount entries rounded up to a power of two, or twice
+    /// the point count when zero.
+    /// </summary>
+    void build(const skVector3* points, SKuint32 count, skScalar cellSize, SKuint32 bucketCount = 0);
+
+    SKuint32 size() const
+    {
+        return (SKuint32)m_indices.size();
+    }
+
+    skScalar cellSize() const
+    {
+        return m_cellSize;
+    }
+
+    SKuint32 bucketCount() const
+    {
+        return m_mask + 1;
+    }
+
+    SKuint32 bucketOf(const skVector3& point) const
+    {
+        return bucketOf(cell(point.x), cell(point.y), cell(point.z));
+    }
+
+    SKuint32 bucketOf(SKint32 x, SKint32 y, SKint32 z) const
+    {
+        return ((SKuint32)x * 73856093u ^ (SKuint32)y * 19349663u ^ (SKuint32)z * 83492791u) & m_mask;
+    }
+
+    // Clamped to the SKint32 range, where the cast alone is undefined. A
+    // query reaching the limits spans more cells than the table holds,
+    // so it searches every bucket anyway.
+    SKint32 cell(skScalar v) const
+    {
+        const skScalar c = skFloor(v * m_invCellSize);
+        if (c >= skScalar(2147483647))
+            return 0x7FFFFFFF;
+        if (!(c > skScalar(-2147483648.0)))
+            return -0x7FFFFFFF - 1;
+        return (SKint32)c;
+    }
+
+    /// <summary>
+    /// The original indices of the points, in bucket order.
+    /// </summary>
+    const SKuint32* sortedIndices() const
+    {
+        return m_indices.data();
+    }
+
+    /// <summary>
+    /// The points, in bucket order.
+    /// </summary>
+    const skVector3* sortedPoints() const
+    {
+        return m_points.data();
+    }
+
+    /// <summary>
+    /// The range [first, last) of bucket b in the sorted arrays.
+    /// </summary>
+    void bucketRange(SKuint32 b, SKuint32& first, SKuint32& last) const
+    {
+        first = m_start[b];
+        last  = m_start[b + 1];
+    }
+
+    /// <summary>
+    /// Calls fn(bucket, first, last) for each non empty bucket, where
+    /// [first, last) indexes the sorted arrays.
+    /// </summary>
+    template <typename Fn>
+    void forEachBucket(Fn&& fn) const
+    {
+        for (SKuint32 b = 0; b <= m_mask; ++b)
+        {
+            if (m_start[b] != m_start[b + 1])
+                fn(b, m_start[b], m_start[b + 1]);
+        }
+    }
+
+    /// <summary>
+    /// Calls fn(index, distanceSquared) once for every point within
+    /// radius of center, where index is the original point index.
+    /// </summary>
+    template <typename Fn>
+    void query(const skVector3& center, skScalar radius, Fn&& fn) const
+    {
+        if (m_indices.empty())
+            return;
+
+        const skScalar r2 = radius * radius;
+
+        std::vector<SKuint32> spill;
+        SKuint32              local[64];
+        const SKuint32*       buckets = local;
+        const SKuint32        n       = gatherBuckets(center, radius, local, spill);
+        if (!spill.empty())
+            buckets = spill.data();
+
+        for (SKuint32 k = 0; k < n; ++k)
+        {
+            const SKuint32 b = buckets[k];
+            for (SKuint32 i = m_start[b]; i < m_start[b + 1]; ++i)
+            {
+                const skScalar d2 = m_points[i].distance2(center);
+                if (d2 <= r2)
+                    fn(m_indices[i], d2);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Appends the original indices of the points within radius of
+    /// center to out and returns how many were added.
+    /// </summary>
+    SKsize query(std::vector<SKuint32>& out, const skVector3& center, skScalar radius) const;
+
+private:
+    SKuint32 gatherBuckets(const skVector3&       center,
+                           skScalar               radius,
+                           SKuint32*              local,
+                           std::vector<SKuint32>& spill) const;
+
+    SKuint32               m_threads;
+    SKuint32               m_mask;
+    skScalar               m_cellSize;
+    skScalar               m_invCellSize;
+    std::vector<SKuint32>  m_start;
+    std::vector<SKuint32>  m_indices;
+    std::vector<skVector3> m_points;
+    std::vector<SKuint32>  m_keys;
+    std::vector<SKuint32>  m_scratch[2];
+    std::vector<SKuint32>  m_histogram;
+};
+
+#endif  //_skSpatialHash_h_
@@ -0,0 +1,326 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skSweepAndPrune.h"
+#include <algorithm>
+#include "skFrameArena.h"
+#include "skParallel.h"
+#include "skSimd.h"
+
+namespace
+{
+    // Items per worker before threads pay off.
+    const SKsize SortGrain  = 16384;
+    const SKsize SweepGrain = 4096;
+
+    // Sentinel entries after the last box.
+    const SKsize Padding = 4;
+
+    SK_INLINE skScalar lower(const skBoundingBox3D& box, int axis)
+    {
+        return (&box.x1)[axis];
+    }
+
+    SK_INLINE skScalar upper(const skBoundingBox3D& box, int axis)
+    {
+        return (&box.x2)[axis];
+    }
+}  // namespace
+
+skSweepAndPrune::skSweepAndPrune() :
+    m_threads(0),
+    m_axis(0)
+{
+}
+
+void skSweepAndPrune::clear()
+{
+    m_boxes.clear();
+    m_sorted.clear();
+    m_pairs.clear();
+}
+
+void skSweepAndPrune::update(const skBoundingBox3D* boxes, SKuint32 count)
+{
+    m_boxes.assign(boxes, boxes + count);
+    update();
+}
+
+void skSweepAndPrune::update(const skBoundingBox2D* boxes, SKuint32 count)
+{
+    m_boxes.resize(count);
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        const skBoundingBox2D& b = boxes[i];
+        m_boxes[i]               = skBoundingBox3D(b.x1, b.y1, 0, b.x2, b.y2, 0);
+    }
+    update();
+}
+
+void skSweepAndPrune::update()
+{
+    if (m_sorted.size() != m_boxes.size())
+        fullSort();
+    else
+    {
+        for (Endpoint& e : m_sorted)
+            e.lo = lower(m_boxes[e.id], m_axis);
+
+        if (!insertionSort())
+            fullSort();
+    }
+    sweep();
+}
+
+void skSweepAndPrune::chooseAxis()
+{
+    const SKsize n = m_boxes.size();
+    if (n == 0)
+        return;
+
+    skScalar mean[3] = {0, 0, 0}, var[3] = {0, 0, 0};
+    for (const skBoundingBox3D& b : m_boxes)
+    {
+        for (int k = 0; k < 3; ++k)
+            mean[k] += lower(b, k) + upper(b, k);
+    }
+    for (int k = 0; k < 3; ++k)
+        mean[k] /= skScalar(2 * n);
+
+    for (const skBoundingBox3D& b : m_boxes)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            const skScalar d = (lower(b, k) + upper(b, k)) * skScalar(0.5) - mean[k];
+            var[k] += d * d;
+        }
+    }
+
+    m_axis = 0;
+    if (var[1] > var[m_axis])
+        m_axis = 1;
+    if (var[2] > var[m_axis])
+        m_axis = 2;
+}
+
+void skSweepAndPrune::fullSort()
+{
+    chooseAxis();
+
+    const SKsize n = m_boxes.size();
+    m_sorted.resize(n);
+    m_scratch.resize(n);
+
+    for (SKsize i = 0; i < n; ++i)
+        m_sorted[i] = {lower(m_boxes[i], m_axis), (SKuint32)i};
+
+    const auto less = [](const Endpoint& a, const Endpoint& b) {
+        return a.lo < b.lo || (a.lo == b.lo && a.id < b.id);
+    };
+
+    // Sort one run per worker, then merge the runs pairwise. The run
+    // lists are scratch from the frame arena of this thread.
+    typedef std::pair<SKsize, SKsize> Run;
+
+    skFrameArena&             arena = skFrameArena::local();
+    const skFrameArena::Scope scope(arena);
+
+    skSpan<Run> runs = arena.allocate<Run>(skParallel::chunkCount(n, SortGrain, m_threads));
+
+    skParallel::forChunks(
+        n,
+        SortGrain,
+        [&](SKsize chunk, SKsize first, SKsize last) {
+            std::sort(m_sorted.begin() + first, m_sorted.begin() + last, less);
+            runs[chunk] = {first, last};
+        },
+        m_threads);
+
+    Endpoint* src = m_sorted.data();
+    Endpoint* dst = m_scratch.data();
+
+    while (runs.size() > 1)
+    {
+        skSpan<Run> merged = arena.allocate<Run>((runs.size() + 1) / 2);
+
+        skParallel::forChunks(
+            merged.size(),
+            1,
+            [&](SKsize, SKsize first, SKsize last) {
+                for (SKsize p = first; p < last; ++p)
+                {
+                    const auto& a = runs[2 * p];
+                    if (2 * p + 1 < runs.size())
+                    {
+                        const auto& b = runs[2 * p + 1];
+                        std::merge(src + a.first, src + a.second, src + b.first, src + b.second, dst + a.first, less);
+                        merged[p] = {a.first, b.second};
+                    }
+                    else
+                    {
+                        std::copy(src + a.first, src + a.second, dst + a.first);
+                        merged[p] = a;
+                    }
+                }
+            },
+            m_threads);
+
+        std::swap(src, dst);
+        runs = merged;
+    }
+
+    if (src != m_sorted.data())
+        m_sorted.swap(m_scratch);
+}
+
+bool skSweepAndPrune::insertionSort()
+{
+    const SKsize n     = m_sorted.size();
+    const SKsize limit = 16 * n + 1024;
+    SKsize       moves = 0;
+
+    for (SKsize i = 1; i < n; ++i)
+    {
+        const Endpoint e = m_sorted[i];
+
+        SKsize j = i;
+        while (j > 0 && (e.lo < m_sorted[j - 1].lo || (e.lo == m_sorted[j - 1].lo && e.id < m_sorted[j - 1].id)))
+        {
+            m_sorted[j] = m_sorted[j - 1];
+            --j;
+
+            // Too far from sorted; leave it to the full sort.
+            if (++moves > limit)
+            {
+                m_sorted[j] = e;
+                return false;
+            }
+        }
+        m_sorted[j] = e;
+    }
+    return true;
+}
+
+void skSweepAndPrune::sweep()
+{
+    const SKsize n  = m_sorted.size();
+    const int    a1 = (m_axis + 1) % 3;
+    const int    a2 = (m_axis + 2) % 3;
+
+    // Gather the bounds in sorted order so that the sweep reads them
+    // sequentially. The padding never overlaps anything and lets the
+    // vector loop read past the end.
+    for (std::vector<skScalar>& b : m_bounds)
+        b.resize(n + Padding);
+
+    skScalar* key = m_bounds[0].data();
+    skScalar* hi  = m_bounds[1].data();
+    skScalar* lo1 = m_bounds[2].data();
+    skScalar* hi1 = m_bounds[3].data();
+    skScalar* lo2 = m_bounds[4].data();
+    skScalar* hi2 = m_bounds[5].data();
+
+    for (SKsize k = 0; k < n; ++k)
+    {
+        const skBoundingBox3D& b = m_boxes[m_sorted[k].id];
+
+        key[k] = m_sorted[k].lo;
+        hi[k]  = upper(b, m_axis);
+        lo1[k] = lower(b, a1);
+        hi1[k] = upper(b, a1);
+        lo2[k] = lower(b, a2);
+        hi2[k] = upper(b, a2);
+    }
+
+    for (SKsize k = n; k < n + Padding; ++k)
+    {
+        key[k] = lo1[k] = lo2[k] = SK_INFINITY;
+        hi[k] = hi1[k] = hi2[k] = -SK_INFINITY;
+    }
+
+    m_chunks.resize(skParallel::chunkCount(n, SweepGrain, m_threads));
+
+    const Endpoint* sorted = m_sorted.data();
+
+    skParallel::forChunks(
+        n,
+        SweepGrain,
+        [&](SKsize chunk, SKsize first, SKsize last) {
+            std::vector<Pair>& out = m_chunks[chunk];
+            out.clear();
+
+            for (SKsize k = first; k < last; ++k)
+            {
+                const SKuint32 i = sorted[k].id;
+                SKsize         j = k + 1;
+
+#ifndef SK_DOUBLE
+                // Four candidates at a time until the keys pass hi[k].
+                const skSimd4f h(hi[k]);
+                const skSimd4f l1(lo1[k]), h1(hi1[k]);
+                const skSimd4f l2(lo2[k]), h2(hi2[k]);
+
+                for (;; j += 4)
+                {
+                    const skSimd4f inRange = skSimd4f::load(key + j) <= h;
+
+                    const skSimd4f hit = inRange &
+                                         (skSimd4f::load(lo1 + j) <= h1) &
+                                         (l1 <= skSimd4f::load(hi1 + j)) &
+                                         (skSimd4f::load(lo2 + j) <= h2) &
+                                         (l2 <= skSimd4f::load(hi2 + j));
+
+                    int bits = skSimdMask(hit);
+                    if (j + 4 > n)
+                        bits &= (1 << (n - j)) - 1;
+
+                    for (; bits != 0; bits &= bits - 1)
+                    {
+                        int lane = 0;
+                        while (!(bits & (1 << lane)))
+                            ++lane;
+
+                        const SKuint32 o = sorted[j + lane].id;
+                        out.push_back(i < o ? Pair{i, o} : Pair{o, i});
+                    }
+
+                    if (skSimdMask(inRange) != 0xF || j + 4 >= n)
+                        break;
+                }
+#else
+                for (; j < n && key[j] <= hi[k]; ++j)
+                {
+                    if (lo1[j] <= hi1[k] && lo1[k] <= hi1[j] &&
+                        lo2[j] <= hi2[k] && lo2[k] <= hi2[j])
+                    {
+                        const SKuint32 o = sorted[j].id;
+                        out.push_back(i < o ? Pair{i, o} : Pair{o, i});
+                    }
+                }
+#endif
+            }
+        },
+        m_threads);
+
+    m_pairs.clear();
+    for (const std::vector<Pair>& out : m_chunks)
+        m_pairs.insert(m_pairs.end(), out.begin(), out.end());
+}
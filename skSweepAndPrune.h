@@ -0,0 +1,115 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSweepAndPrune_h_
+#define _skSweepAndPrune_h_
+
+#include <vector>
+#include "skBoundingBox2D.h"
+#include "skBoundingBox3D.h"
+
+/// <summary>
+/// Persistent sort and sweep broad phase. Boxes are identified by their
+/// index in the array passed to update. The sorted order is kept between
+/// updates and repaired with an insertion sort, which is close to linear
+/// while bodies move a little per step. The first update, a change in
+/// the body count or a large reshuffle falls back to a full sort that
+/// runs on skParallel.
+/// </summary>
+class skSweepAndPrune
+{
+public:
+    /// <summary>
+    /// An overlapping pair of box indices, with a < b.
+    /// </summary>
+    struct Pair
+    {
+        SKuint32 a, b;
+    };
+
+public:
+    skSweepAndPrune();
+
+    void clear();
+
+    /// <summary>
+    /// Limits the workers used by the full sort and the sweep. Zero uses
+    /// every hardware thread.
+    /// </summary>
+    void setThreadCount(SKuint32 threads)
+    {
+        m_threads = threads;
+    }
+
+    void update(const skBoundingBox3D* boxes, SKuint32 count);
+
+    /// <summary>
+    /// The 2D form, treating every box as flat in z.
+    /// </summary>
+    void update(const skBoundingBox2D* boxes, SKuint32 count);
+
+    /// <summary>
+    /// The pairs found by the last update. They are grouped by the box
+    /// that comes first along the sweep axis.
+    /// </summary>
+    const Pair* pairs() const
+    {
+        return m_pairs.data();
+    }
+
+    SKsize pairCount() const
+    {
+        return m_pairs.size();
+    }
+
+    /// <summary>
+    /// The axis the boxes are sorted on, chosen on a full sort as the one
+    /// with the largest spread of box centers.
+    /// </summary>
+    int axis() const
+    {
+        return m_axis;
+    }
+
+private:
+    struct Endpoint
+    {
+        skScalar lo;
+        SKuint32 id;
+    };
+
+    void update();
+    void chooseAxis();
+    void fullSort();
+    bool insertionSort();
+    void sweep();
+
+    SKuint32                       m_threads;
+    int                            m_axis;
+    std::vector<skBoundingBox3D>   m_boxes;
+    std::vector<Endpoint>          m_sorted;
+    std::vector<Endpoint>          m_scratch;
+    std::vector<skScalar>          m_bounds[6];
+    std::vector<std::vector<Pair>> m_chunks;
+    std::vector<Pair>              m_pairs;
+};
+
+#endif  //_skSweepAndPrune_h_
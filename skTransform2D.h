@@ -35,7 +35,7 @@ public:
         copy(t);
     }
 
-    skTransform2D(skScalar _xx,  
+    constexpr skTransform2D(skScalar _xx,
                   skScalar _xy,
                   skScalar _tx,
                   skScalar _yx,
@@ -67,10 +67,9 @@ public:
         }
     }
 
-    skTransform2D(const skTransform2D& v)
-    {
-        copy(v.p);
-    }
+    constexpr skTransform2D(const skTransform2D& v) = default;
+
+    constexpr skTransform2D& operator=(const skTransform2D& v) = default;
 
     SK_INLINE void setTranslation(const skVector2& v)
     {
@@ -140,8 +139,8 @@ public:
 
     union
     {
-        skScalar m[3][3];
-        skScalar p[9]{};
+        skScalar m[3][3]{};
+        skScalar p[9];
     };
 
 public:
@@ -163,4 +162,7 @@ private:
     }
 };
 
+inline constexpr skTransform2D skTransform2D::Identity = skTransform2D(1, 0, 0, 0, 1, 0, 0, 0, 1);
+inline constexpr skTransform2D skTransform2D::Zero     = skTransform2D(0, 0, 0, 0, 0, 0, 0, 0, 0);
+
 #endif  //_skTransform2D_h_
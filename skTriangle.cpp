@@ -0,0 +1,285 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skTriangle.h"
+#include <cstdio>
+#include "skSimdKernels.inl"
+
+namespace
+{
+    bool mollerTrumbore(const skRay&     ray,
+                        const skVector3& v0,
+                        const skVector3& e1,
+                        const skVector3& e2,
+                        const skVector2& limit,
+                        skScalar&        t,
+                        skScalar&        u,
+                        skScalar&        v)
+    {
+        const skVector3 p   = ray.direction.cross(e2);
+        const skScalar  det = e1.dot(p);
+        if (det == 0)
+            return false;
+
+        const skScalar  inv = 1 / det;
+        const skVector3 s   = ray.origin - v0;
+
+        u = s.dot(p) * inv;
+        if (u < 0 || u > 1)
+            return false;
+
+        const skVector3 q = s.cross(e1);
+
+        v = ray.direction.dot(q) * inv;
+        if (v < 0 || u + v > 1)
+            return false;
+
+        t = e2.dot(q) * inv;
+        return t >= limit.x && t <= limit.y;
+    }
+
+    SK_INLINE skVector3 lane(const skScalar (&a)[3][skTriangleBlock::Width], SKuint32 l)
+    {
+        return skVector3(a[0][l], a[1][l], a[2][l]);
+    }
+}  // namespace
+
+bool skTriangle::hit(skScalar& t, skScalar& u, skScalar& v, const skRay& ray, const skVector2& limit) const
+{
+    return mollerTrumbore(ray, v0, v1 - v0, v2 - v0, limit, t, u, v);
+}
+
+bool skTriangle::hit(skRayHitTest& ht, const skRay& ray, const skVector2& limit) const
+{
+    skScalar u, v;
+    if (hit(ht.distance, u, v, ray, limit))
+    {
+        ht.point  = ray.at(ht.distance);
+        ht.normal = normal();
+        return true;
+    }
+    return false;
+}
+
+bool skTriangle::hitWatertight(skScalar& t, skScalar& u, skScalar& v, const skRay& ray, const skVector2& limit) const
+{
+    const skScalar* dir = ray.direction.ptr();
+
+    // Shear the ray onto +z, with z its dominant axis, and keep the
+    // winding by swapping x and y when z points down.
+    const skVector3 ad = ray.direction.abs();
+
+    int kz = 0;
+    if (ad.y > ad.x)
+        kz = 1;
+    if (ad.z > ad.ptr()[kz])
+        kz = 2;
+    if (dir[kz] == 0)
+        return false;
+
+    int kx = (kz + 1) % 3;
+    int ky = (kx + 1) % 3;
+    if (dir[kz] < 0)
+    {
+        const int tmp = kx;
+        kx = ky, ky = tmp;
+    }
+
+    const skScalar sx = dir[kx] / dir[kz];
+    const skScalar sy = dir[ky] / dir[kz];
+    const skScalar sz = 1 / dir[kz];
+
+    const skVector3 a = v0 - ray.origin;
+    const skVector3 b = v1 - ray.origin;
+    const skVector3 c = v2 - ray.origin;
+
+    const skScalar ax = a.ptr()[kx] - sx * a.ptr()[kz];
+    const skScalar ay = a.ptr()[ky] - sy * a.ptr()[kz];
+    const skScalar bx = b.ptr()[kx] - sx * b.ptr()[kz];
+    const skScalar by = b.ptr()[ky] - sy * b.ptr()[kz];
+    const skScalar cx = c.ptr()[kx] - sx * c.ptr()[kz];
+    const skScalar cy = c.ptr()[ky] - sy * c.ptr()[kz];
+
+    // Scaled barycentrics of v0, v1 and v2.
+    skScalar e0 = cx * by - cy * bx;
+    skScalar e1 = ax * cy - ay * cx;
+    skScalar e2 = bx * ay - by * ax;
+
+#ifndef SK_DOUBLE
+    // On an edge the single precision sign is not reliable.
+    if (e0 == 0 || e1 == 0 || e2 == 0)
+    {
+        e0 = (float)((double)cx * (double)by - (double)cy * (double)bx);
+        e1 = (float)((double)ax * (double)cy - (double)ay * (double)cx);
+        e2 = (float)((double)bx * (double)ay - (double)by * (double)ax);
+    }
+#endif
+
+    if ((e0 < 0 || e1 < 0 || e2 < 0) && (e0 > 0 || e1 > 0 || e2 > 0))
+        return false;
+
+    const skScalar det = e0 + e1 + e2;
+    if (det == 0)
+        return false;
+
+    const skScalar az = sz * a.ptr()[kz];
+    const skScalar bz = sz * b.ptr()[kz];
+    const skScalar cz = sz * c.ptr()[kz];
+
+    const skScalar inv = 1 / det;
+
+    t = (e0 * az + e1 * bz + e2 * cz) * inv;
+    if (t < limit.x || t > limit.y)
+        return false;
+
+    u = e1 * inv;
+    v = e2 * inv;
+    return true;
+}
+
+bool skTriangle::hitWatertight(skRayHitTest& ht, const skRay& ray, const skVector2& limit) const
+{
+    skScalar u, v;
+    if (hitWatertight(ht.distance, u, v, ray, limit))
+    {
+        ht.point  = ray.at(ht.distance);
+        ht.normal = normal();
+        return true;
+    }
+    return false;
+}
+
+void skTriangle::print() const
+{
+    printf("A[%3.3f, %3.3f, %3.3f]\n", (double)v0.x, (double)v0.y, (double)v0.z);
+    printf("B[%3.3f, %3.3f, %3.3f]\n", (double)v1.x, (double)v1.y, (double)v1.z);
+    printf("C[%3.3f, %3.3f, %3.3f]\n", (double)v2.x, (double)v2.y, (double)v2.z);
+}
+
+void skTriangleBlock::clear()
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        for (SKuint32 l = 0; l < Width; ++l)
+            v0[i][l] = e1[i][l] = e2[i][l] = 0;
+    }
+}
+
+void skTriangleBlock::set(SKuint32 lane, const skTriangle& tri)
+{
+    const skVector3 a = tri.v1 - tri.v0;
+    const skVector3 b = tri.v2 - tri.v0;
+    for (int i = 0; i < 3; ++i)
+    {
+        v0[i][lane] = tri.v0.ptr()[i];
+        e1[i][lane] = a.ptr()[i];
+        e2[i][lane] = b.ptr()[i];
+    }
+}
+
+void skTriangleBlock::pack(skTriangleBlock* blocks, const skTriangle* triangles, SKsize count)
+{
+    const SKsize n = blockCount(count);
+    for (SKsize b = 0; b < n; ++b)
+    {
+        blocks[b].clear();
+        for (SKuint32 l = 0; l < Width && b * Width + l < count; ++l)
+            blocks[b].set(l, triangles[b * Width + l]);
+    }
+}
+
+int skTriangleBlock::hit(skScalar& t, const skRay& ray, const skVector2& limit) const
+{
+    int best = -1;
+
+#ifndef SK_DOUBLE
+    static_assert(Width == BlockWidth && sizeof(skTriangleBlock) == 9 * Width * sizeof(float), "skTriangleBlock does not match the kernel layout");
+
+    float rd[6];
+    for (int i = 0; i < 3; ++i)
+    {
+        rd[i]     = ray.origin.ptr()[i];
+        rd[3 + i] = ray.direction.ptr()[i];
+    }
+
+    float r[Width];
+    skSimdDispatch::kernels().triangleBlock(r, v0[0], rd, limit.x, limit.y);
+
+    float closest = SK_INFINITY;
+    for (SKuint32 l = 0; l < Width; ++l)
+    {
+        if (r[l] < closest)
+            closest = r[l], best = (int)l;
+    }
+    if (best >= 0)
+        t = closest;
+#else
+    skVector2 range = limit;
+    for (SKuint32 l = 0; l < Width; ++l)
+    {
+        skScalar tl, u, v;
+        if (mollerTrumbore(ray, lane(v0, l), lane(e1, l), lane(e2, l), range, tl, u, v))
+        {
+            t       = tl;
+            range.y = tl;
+            best    = (int)l;
+        }
+    }
+#endif
+    return best;
+}
+
+bool skTriangleBlock::hit(skRayHitTest&          ht,
+                          SKuint32&              index,
+                          const skRay&           ray,
+                          const skVector2&       limit,
+                          const skTriangleBlock* blocks,
+                          SKsize                 count)
+{
+    skVector2 range = limit;
+
+    SKsize best = count;
+    int    lb   = -1;
+
+    for (SKsize b = 0; b < count; ++b)
+    {
+        skScalar t;
+
+        const int l = blocks[b].hit(t, ray, range);
+        if (l >= 0)
+        {
+            range.y = t;
+            best    = b;
+            lb      = l;
+        }
+    }
+
+    if (lb < 0)
+        return false;
+
+    const skTriangleBlock& blk = blocks[best];
+
+    index       = (SKuint32)(best * Width + (SKuint32)lb);
+    ht.distance = range.y;
+    ht.point    = ray.at(range.y);
+    ht.normal   = lane(blk.e1, (SKuint32)lb).cross(lane(blk.e2, (SKuint32)lb)).normalized();
+    return true;
+}
@@ -0,0 +1,128 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skTriangle_h_
+#define _skTriangle_h_
+
+#include "Math/skRay.h"
+#include "Math/skVector2.h"
+
+class skTriangle
+{
+public:
+    skVector3 v0, v1, v2;
+
+public:
+    skTriangle() = default;
+
+    skTriangle(const skVector3& a, const skVector3& b, const skVector3& c) :
+        v0(a),
+        v1(b),
+        v2(c)
+    {
+    }
+
+    /// <summary>
+    /// The unit normal, wound counter clockwise.
+    /// </summary>
+    SK_INLINE skVector3 normal() const
+    {
+        return (v1 - v0).cross(v2 - v0).normalized();
+    }
+
+    /// <summary>
+    /// Moller-Trumbore test against both sides, accepting
+    /// limit.x <= t <= limit.y. u and v are the weights of v1 and v2 at
+    /// the hit.
+    /// </summary>
+    bool hit(skScalar& t, skScalar& u, skScalar& v, const skRay& ray, const skVector2& limit) const;
+
+    bool hit(skRayHitTest& ht, const skRay& ray, const skVector2& limit) const;
+
+    /// <summary>
+    /// Watertight test, after Woop, Benthin and Wald. Slower than hit,
+    /// but a ray through a shared edge or vertex of a closed mesh always
+    /// hits at least one of the triangles sharing it.
+    /// </summary>
+    bool hitWatertight(skScalar& t, skScalar& u, skScalar& v, const skRay& ray, const skVector2& limit) const;
+
+    bool hitWatertight(skRayHitTest& ht, const skRay& ray, const skVector2& limit) const;
+
+    void print() const;
+};
+
+/// <summary>
+/// Eight triangles in structure of arrays form, stored as a corner and
+/// two edges so the Moller-Trumbore test runs across the lanes. Empty
+/// lanes never hit.
+/// </summary>
+class skTriangleBlock
+{
+public:
+    static const SKuint32 Width = 8;
+
+    skScalar v0[3][Width];
+    skScalar e1[3][Width];
+    skScalar e2[3][Width];
+
+public:
+    skTriangleBlock()
+    {
+        clear();
+    }
+
+    void clear();
+
+    void set(SKuint32 lane, const skTriangle& tri);
+
+    /// <summary>
+    /// Returns the number of blocks needed for count triangles.
+    /// </summary>
+    static SKsize blockCount(SKsize count)
+    {
+        return (count + Width - 1) / Width;
+    }
+
+    /// <summary>
+    /// Packs count triangles into blockCount(count) blocks. Triangle i
+    /// goes to lane i % Width of block i / Width.
+    /// </summary>
+    static void pack(skTriangleBlock* blocks, const skTriangle* triangles, SKsize count);
+
+    /// <summary>
+    /// Returns the lane of the closest hit with limit.x <= t <= limit.y,
+    /// or -1 when no lane is hit.
+    /// </summary>
+    int hit(skScalar& t, const skRay& ray, const skVector2& limit) const;
+
+    /// <summary>
+    /// Closest hit over count blocks. index receives the triangle index,
+    /// block * Width + lane.
+    /// </summary>
+    static bool hit(skRayHitTest&          ht,
+                    SKuint32&              index,
+                    const skRay&           ray,
+                    const skVector2&       limit,
+                    const skTriangleBlock* blocks,
+                    SKsize                 count);
+};
+
+#endif  //_skTriangle_h_
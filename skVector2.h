@@ -31,13 +31,13 @@ public:
     {
     }
 
-    skVector2(const skScalar nx, const skScalar ny) :
+    constexpr skVector2(const skScalar nx, const skScalar ny) :
         x(nx),
         y(ny)
     {
     }
 
-    explicit skVector2(skScalar* p) :
+    constexpr explicit skVector2(skScalar* p) :
         x(p[0]),
         y(p[1])
     {
@@ -55,155 +55,155 @@ public:
         return &x;
     }
 
-    skVector2& operator=(const skVector2& v) = default;
+    constexpr skVector2& operator=(const skVector2& v) = default;
 
-    SK_INLINE bool operator==(const skVector2& v) const
+    SK_INLINE constexpr bool operator==(const skVector2& v) const
     {
         return skEq(x, v.x) && skEq(y, v.y);
     }
 
-    SK_INLINE bool operator!=(const skVector2& v) const
+    SK_INLINE constexpr bool operator!=(const skVector2& v) const
     {
         return !skEq(x, v.x) && !skEq(y, v.y);
     }
 
-    SK_INLINE bool operator<(const skVector2& v) const
+    SK_INLINE constexpr bool operator<(const skVector2& v) const
     {
         return x < v.x && y < v.y;
     }
 
-    SK_INLINE bool operator>(const skVector2& v) const
+    SK_INLINE constexpr bool operator>(const skVector2& v) const
     {
         return x > v.x && y > v.y;
     }
 
-    SK_INLINE bool operator<=(const skVector2& v) const
+    SK_INLINE constexpr bool operator<=(const skVector2& v) const
     {
         return x <= v.x && y <= v.y;
     }
 
-    SK_INLINE bool operator>=(const skVector2& v) const
+    SK_INLINE constexpr bool operator>=(const skVector2& v) const
     {
         return x >= v.x && y >= v.y;
     }
 
-    SK_INLINE skVector2 operator+(skScalar v) const
+    SK_INLINE constexpr skVector2 operator+(skScalar v) const
     {
         return skVector2(x + v, y + v);
     }
 
-    SK_INLINE skVector2 operator+(const skVector2& v) const
+    SK_INLINE constexpr skVector2 operator+(const skVector2& v) const
     {
         return skVector2(x + v.x, y + v.y);
     }
 
-    SK_INLINE skVector2& operator+=(skScalar v)
+    SK_INLINE constexpr skVector2& operator+=(skScalar v)
     {
         x += v;
         y += v;
         return *this;
     }
 
-    SK_INLINE skVector2& operator+=(const skVector2& v)
+    SK_INLINE constexpr skVector2& operator+=(const skVector2& v)
     {
         x += v.x;
         y += v.y;
         return *this;
     }
 
-    friend SK_INLINE skVector2 operator+(skScalar r, const skVector2& l)
+    friend SK_INLINE constexpr skVector2 operator+(skScalar r, const skVector2& l)
     {
         return skVector2(l.x + r, l.y + r);
     }
 
-    SK_INLINE skVector2 operator-(skScalar v) const
+    SK_INLINE constexpr skVector2 operator-(skScalar v) const
     {
         return skVector2(x - v, y - v);
     }
 
-    SK_INLINE skVector2 operator-(const skVector2& v) const
+    SK_INLINE constexpr skVector2 operator-(const skVector2& v) const
     {
         return skVector2(x - v.x, y - v.y);
     }
 
-    SK_INLINE skVector2& operator-=(skScalar v)
+    SK_INLINE constexpr skVector2& operator-=(skScalar v)
     {
         x -= v;
         y -= v;
         return *this;
     }
 
-    SK_INLINE skVector2& operator-=(const skVector2& v)
+    SK_INLINE constexpr skVector2& operator-=(const skVector2& v)
     {
         x -= v.x;
         y -= v.y;
         return *this;
     }
 
-    SK_INLINE skVector2 operator-() const
+    SK_INLINE constexpr skVector2 operator-() const
     {
         return skVector2(-x, -y);
     }
 
-    friend SK_INLINE skVector2 operator-(skScalar r, const skVector2& l)
+    friend SK_INLINE constexpr skVector2 operator-(skScalar r, const skVector2& l)
     {
         return skVector2(l.x - r, l.y - r);
     }
 
-    SK_INLINE skVector2 operator*(skScalar v) const
+    SK_INLINE constexpr skVector2 operator*(skScalar v) const
     {
         return skVector2(x * v, y * v);
     }
 
-    SK_INLINE skVector2 operator*(const skVector2& v) const
+    SK_INLINE constexpr skVector2 operator*(const skVector2& v) const
     {
         return skVector2(x * v.x, y * v.y);
     }
 
-    SK_INLINE skVector2& operator*=(skScalar v)
+    SK_INLINE constexpr skVector2& operator*=(skScalar v)
     {
         x *= v;
         y *= v;
         return *this;
     }
 
-    SK_INLINE skVector2& operator*=(const skVector2& v)
+    SK_INLINE constexpr skVector2& operator*=(const skVector2& v)
     {
         x *= v.x;
         y *= v.y;
         return *this;
     }
 
-    friend SK_INLINE skVector2 operator*(skScalar r, const skVector2& l)
+    friend SK_INLINE constexpr skVector2 operator*(skScalar r, const skVector2& l)
     {
         return skVector2(l.x * r, l.y * r);
     }
 
-    SK_INLINE skVector2 operator/(skScalar v) const
+    SK_INLINE constexpr skVector2 operator/(skScalar v) const
     {
         return skVector2(x / v, y / v);
     }
 
-    SK_INLINE skVector2 operator/(const skVector2& v) const
+    SK_INLINE constexpr skVector2 operator/(const skVector2& v) const
     {
         return skVector2(x / v.x, y / v.y);
     }
 
-    SK_INLINE skVector2& operator/=(skScalar v)
+    SK_INLINE constexpr skVector2& operator/=(skScalar v)
     {
         x /= v;
         y /= v;
         return *this;
     }
 
-    SK_INLINE skVector2& operator/=(const skVector2& v)
+    SK_INLINE constexpr skVector2& operator/=(const skVector2& v)
     {
         x /= v.x;
         y /= v.y;
         return *this;
     }
 
-    friend SK_INLINE skVector2 operator/(skScalar r, const skVector2& l)
+    friend SK_INLINE constexpr skVector2 operator/(skScalar r, const skVector2& l)
     {
         return skVector2(l.x / r, l.y / r);
     }
@@ -213,17 +213,17 @@ public:
         return skSqrt(length2());
     }
 
-    SK_INLINE skScalar length2() const
+    SK_INLINE constexpr skScalar length2() const
     {
         return dot(*this);
     }
 
-    SK_INLINE skScalar dot(const skVector2& v) const
+    SK_INLINE constexpr skScalar dot(const skVector2& v) const
     {
         return x * v.x + y * v.y;
     }
 
-    SK_INLINE skVector2 abs() const
+    SK_INLINE constexpr skVector2 abs() const
     {
         return skVector2(skAbs(x), skAbs(y));
     }
@@ -233,17 +233,17 @@ public:
         return skVector2(x - v.x, y - v.y).length();
     }
 
-    SK_INLINE skScalar distance2(const skVector2& v) const
+    SK_INLINE constexpr skScalar distance2(const skVector2& v) const
     {
         return skVector2(x - v.x, y - v.y).length2();
     }
 
-    SK_INLINE skVector2 perpendicular() const
+    SK_INLINE constexpr skVector2 perpendicular() const
     {
         return skVector2(-y, x);
     }
 
-    SK_INLINE bool isZero() const
+    SK_INLINE constexpr bool isZero() const
     {
         return skIsZero(x) && skIsZero(y);
     }
@@ -266,17 +266,17 @@ public:
         return v;
     }
 
-    SK_INLINE bool contains(skScalar x1, skScalar y1, skScalar x2, skScalar y2) const
+    SK_INLINE constexpr bool contains(skScalar x1, skScalar y1, skScalar x2, skScalar y2) const
     {
         return x >= x1 && x <= x2 && y >= y1 && y <= y2;
     }
 
-    SK_INLINE skScalar hx() const
+    SK_INLINE constexpr skScalar hx() const
     {
         return x * skScalar(0.5);
     }
 
-    SK_INLINE skScalar hy() const
+    SK_INLINE constexpr skScalar hy() const
     {
         return y * skScalar(0.5);
     }
@@ -303,12 +303,12 @@ public:
         constrainY(y1, y2);
     }
 
-    skScalar minValue() const
+    constexpr skScalar minValue() const
     {
         return x < y ? x : y;
     }
 
-    skScalar maxValue() const
+    constexpr skScalar maxValue() const
     {
         return x > y ? x : y;
     }
@@ -325,4 +325,9 @@ public:
     static const skVector2 Zero;
 };
 
+inline constexpr skVector2 skVector2::Unit  = skVector2(1, 1);
+inline constexpr skVector2 skVector2::UnitX = skVector2(1, 0);
+inline constexpr skVector2 skVector2::UnitY = skVector2(0, 1);
+inline constexpr skVector2 skVector2::Zero  = skVector2(0, 0);
+
 #endif  //_skVector2_h_
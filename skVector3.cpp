@@ -22,21 +22,176 @@
 #include "skVector3.h"
 #include <cstdio>
 #include "skColor.h"
+#include "skMatrix4.h"
+#include "skSimd.h"
+#include "skSimdDispatch.h"
 
-const skVector3 skVector3::Unit  = skVector3(1, 1, 1);
-const skVector3 skVector3::UnitX = skVector3(1, 0, 0);
-const skVector3 skVector3::UnitY = skVector3(0, 1, 0);
-const skVector3 skVector3::UnitZ = skVector3(0, 0, 1);
-const skVector3 skVector3::Zero  = skVector3(0, 0, 0);
-
-void skVector3::print() const
+template <typename T>
+void skVector3T<T>::print() const
 {
     printf("[%3.3f, %3.3f, %3.3f]\n", (double)x, (double)y, (double)z);
 }
 
-skVector3::skVector3(const skColor& col) :
-    x(col.r),
-    y(col.g),
-    z(col.b)
+template <typename T>
+skVector3T<T>::skVector3T(const skColor& col) :
+    x(T(col.r)),
+    y(T(col.g)),
+    z(T(col.b))
+{
+}
+
+template class skVector3T<float>;
+template class skVector3T<double>;
+
+#ifndef SK_DOUBLE
+static_assert(sizeof(skVector3) == 3 * sizeof(float), "the batch kernels read packed vectors");
+#endif
+static_assert(sizeof(skVector3A) == 4 * sizeof(skScalar), "skVector3A is padded to four scalars");
+
+// The scalars of an array of vectors. Unlike ptr(), it is defined for
+// the null data of an empty array.
+template <typename V>
+static skScalar* scalars(V* v)
+{
+    return reinterpret_cast<skScalar*>(v);
+}
+
+template <typename V>
+static const skScalar* scalars(const V* v)
+{
+    return reinterpret_cast<const skScalar*>(v);
+}
+
+// The element wise operations over n packed scalars.
+static void addScalars(skScalar* d, const skScalar* u, const skScalar* v, SKsize n)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    i = skSimdDispatch::kernels().add(d, u, v, n);
+#endif
+    for (; i < n; ++i)
+        d[i] = u[i] + v[i];
+}
+
+static void subScalars(skScalar* d, const skScalar* u, const skScalar* v, SKsize n)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    i = skSimdDispatch::kernels().sub(d, u, v, n);
+#endif
+    for (; i < n; ++i)
+        d[i] = u[i] - v[i];
+}
+
+static void scaleScalars(skScalar* d, const skScalar* u, skScalar s, SKsize n)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    i = skSimdDispatch::kernels().scale(d, u, s, n);
+#endif
+    for (; i < n; ++i)
+        d[i] = u[i] * s;
+}
+
+static void maddScalars(skScalar* d, const skScalar* u, const skScalar* v, skScalar s, SKsize n)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    i = skSimdDispatch::kernels().madd(d, u, v, s, n);
+#endif
+    for (; i < n; ++i)
+        d[i] = u[i] + v[i] * s;
+}
+
+void skVector3Utils::add(skVector3* dst, const skVector3* a, const skVector3* b, SKsize count)
+{
+    addScalars(scalars(dst), scalars(a), scalars(b), 3 * count);
+}
+
+void skVector3Utils::sub(skVector3* dst, const skVector3* a, const skVector3* b, SKsize count)
 {
+    subScalars(scalars(dst), scalars(a), scalars(b), 3 * count);
+}
+
+void skVector3Utils::scale(skVector3* dst, const skVector3* a, skScalar s, SKsize count)
+{
+    scaleScalars(scalars(dst), scalars(a), s, 3 * count);
+}
+
+void skVector3Utils::madd(skVector3* dst, const skVector3* a, const skVector3* b, skScalar s, SKsize count)
+{
+    maddScalars(scalars(dst), scalars(a), scalars(b), s, 3 * count);
+}
+
+void skVector3Utils::transform(skVector3* dst, const skMatrix4& m, const skVector3* src, SKsize count)
+{
+    SKsize i = 0;
+#ifndef SK_DOUBLE
+    i = skSimdDispatch::kernels().transform(scalars(dst), m.p, scalars(src), count);
+#endif
+    for (; i < count; ++i)
+    {
+        // Same order of operations as the kernels.
+        const skVector3 p = src[i];
+        for (int k = 0; k < 3; ++k)
+            dst[i].ptr()[k] = m.m[k][0] * p.x + m.m[k][1] * p.y + m.m[k][2] * p.z + m.m[k][3];
+    }
+}
+
+// The padding lane goes through the same operation as the others, which
+// keeps it at zero.
+void skVector3Utils::add(skVector3A* dst, const skVector3A* a, const skVector3A* b, SKsize count)
+{
+    addScalars(scalars(dst), scalars(a), scalars(b), 4 * count);
+}
+
+void skVector3Utils::sub(skVector3A* dst, const skVector3A* a, const skVector3A* b, SKsize count)
+{
+    subScalars(scalars(dst), scalars(a), scalars(b), 4 * count);
+}
+
+void skVector3Utils::scale(skVector3A* dst, const skVector3A* a, skScalar s, SKsize count)
+{
+    scaleScalars(scalars(dst), scalars(a), s, 4 * count);
+}
+
+void skVector3Utils::madd(skVector3A* dst, const skVector3A* a, const skVector3A* b, skScalar s, SKsize count)
+{
+    maddScalars(scalars(dst), scalars(a), scalars(b), s, 4 * count);
+}
+
+void skVector3Utils::transform(skVector3A* dst, const skMatrix4& m, const skVector3A* src, SKsize count)
+{
+#ifndef SK_DOUBLE
+    // One register per point, with the columns of the top three rows
+    // and zero in the padding lane.
+    float col[4][4];
+    for (int c = 0; c < 4; ++c)
+    {
+        for (int k = 0; k < 3; ++k)
+            col[c][k] = m.m[k][c];
+        col[c][3] = 0;
+    }
+
+    const skSimd4f c0 = skSimd4f::load(col[0]);
+    const skSimd4f c1 = skSimd4f::load(col[1]);
+    const skSimd4f c2 = skSimd4f::load(col[2]);
+    const skSimd4f c3 = skSimd4f::load(col[3]);
+
+    for (SKsize i = 0; i < count; ++i)
+    {
+        const skVector3A& p = src[i];
+
+        const skSimd4f r = c0 * skSimd4f(p.x) + c1 * skSimd4f(p.y) + c2 * skSimd4f(p.z) + c3;
+        r.store(dst[i].ptr());
+    }
+#else
+    for (SKsize i = 0; i < count; ++i)
+    {
+        const skVector3 p = src[i];
+        for (int k = 0; k < 3; ++k)
+            dst[i].ptr()[k] = m.m[k][0] * p.x + m.m[k][1] * p.y + m.m[k][2] * p.z + m.m[k][3];
+        dst[i].w = 0;
+    }
+#endif
 }
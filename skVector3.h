@@ -22,82 +22,104 @@
 #ifndef _skVector3_h_
 #define _skVector3_h_
 
+#include "skAligned.h"
 #include "skMath.h"
 class skColor;
 
-class skVector3
+/// <summary>
+/// Three component vector with the precision given by T.
+/// skVector3 is the skScalar instance, skVector3f and skVector3d are the
+/// fixed precision instances.
+/// </summary>
+template <typename T>
+class skVector3T
 {
 public:
-    skVector3()
+    typedef T            ValueType;
+    typedef skScalarT<T> Traits;
+
+public:
+    skVector3T()
     {
     }
 
-    skVector3(skScalar nx, skScalar ny, skScalar nz) :
+    constexpr skVector3T(T nx, T ny, T nz) :
         x(nx),
         y(ny),
         z(nz)
     {
     }
 
-    explicit skVector3(const skColor& col);
+    explicit skVector3T(const skColor& col);
 
-    explicit skVector3(const float* p)
+    explicit skVector3T(const float* p)
     {
         if (p)
         {
-            x = (skScalar)p[0];
-            y = (skScalar)p[1];
-            z = (skScalar)p[2];
+            x = (T)p[0];
+            y = (T)p[1];
+            z = (T)p[2];
         }
         else
             x = y = z = 0;
     }
 
-    explicit skVector3(const double* p)
+    explicit skVector3T(const double* p)
     {
         if (p)
         {
-            x = (skScalar)p[0];
-            y = (skScalar)p[1];
-            z = (skScalar)p[2];
+            x = (T)p[0];
+            y = (T)p[1];
+            z = (T)p[2];
         }
         else
             x = y = z = 0;
     }
 
-    skVector3(const skVector3& v) = default;
+    skVector3T(const skVector3T& v) = default;
+
+    /// <summary>
+    /// Converts from a vector of a different precision.
+    /// </summary>
+    template <typename U>
+    constexpr explicit skVector3T(const skVector3T<U>& v) :
+        x(T(v.x)),
+        y(T(v.y)),
+        z(T(v.z))
+    {
+    }
 
-    SK_INLINE skScalar* ptr()
+    SK_INLINE T* ptr()
     {
         return &x;
     }
 
-    SK_INLINE const skScalar* ptr() const
+    SK_INLINE const T* ptr() const
     {
         return &x;
     }
 
-    SK_INLINE bool operator==(const skVector3& v) const
+    SK_INLINE constexpr bool operator==(const skVector3T& v) const
     {
-        return skEq(x, v.x) && skEq(y, v.y) && skEq(z, v.z);
+        return Traits::eq(x, v.x) && Traits::eq(y, v.y) && Traits::eq(z, v.z);
     }
 
-    SK_INLINE bool operator!=(const skVector3& v) const
+    SK_INLINE constexpr bool operator!=(const skVector3T& v) const
     {
-        return !skEq(x, v.x) && !skEq(y, v.y) && !skEq(z, v.z);
+        return !Traits::eq(x, v.x) && !Traits::eq(y, v.y) && !Traits::eq(z, v.z);
     }
 
-    SK_INLINE skVector3 operator+(skScalar v) const
+    SK_INLINE constexpr skVector3T operator+(T v) const
     {
-        return skVector3(x + v, y + v, z + v);
+        return skVector3T(x + v, y + v, z + v);
     }
 
-    SK_INLINE skVector3 operator+(const skVector3& v) const
+    SK_INLINE constexpr skVector3T operator+(const skVector3T& v) const
     {
-        return skVector3(x + v.x, y + v.y, z + v.z);
+        return skVector3T(x + v.x, y + v.y, z + v.z);
     }
 
-    skVector3& operator+=(skScalar v)
+    constexpr skVector3T& operator+=(T v)
     {
         x += v;
         y += v;
@@ -105,7 +127,7 @@ public:
         return *this;
     }
 
-    skVector3& operator+=(const skVector3& v)
+    constexpr skVector3T& operator+=(const skVector3T& v)
     {
         x += v.x;
         y += v.y;
@@ -113,44 +135,44 @@ public:
         return *this;
     }
 
-    static void majorAxis(skVector3& dest, const skVector3& src)
+    static void majorAxis(skVector3T& dest, const skVector3T& src)
     {
-        const skScalar m = skMax3(src.x, src.y, src.z);
+        const T m = skMax3(src.x, src.y, src.z);
 
-        if (skEq(m, src.x))
+        if (Traits::eq(m, src.x))
             dest = UnitX;
-        else if (skEq(m, src.y))
+        else if (Traits::eq(m, src.y))
             dest = UnitY;
         else
             dest = UnitZ;
     }
 
-    skVector3 majorAxis() const
+    skVector3T majorAxis() const
     {
-        skVector3 result;
+        skVector3T result;
         majorAxis(result, *this);
         return result;
     }
 
-    skVector3 abs() const
+    constexpr skVector3T abs() const
     {
         return {
-            skAbs(x),
-            skAbs(y),
-            skAbs(z)};
+            Traits::abs(x),
+            Traits::abs(y),
+            Traits::abs(z)};
     }
 
-    SK_INLINE skVector3 operator-(skScalar v) const
+    SK_INLINE constexpr skVector3T operator-(T v) const
     {
-        return skVector3(x - v, y - v, z - v);
+        return skVector3T(x - v, y - v, z - v);
     }
 
-    SK_INLINE skVector3 operator-(const skVector3& v) const
+    SK_INLINE constexpr skVector3T operator-(const skVector3T& v) const
     {
-        return skVector3(x - v.x, y - v.y, z - v.z);
+        return skVector3T(x - v.x, y - v.y, z - v.z);
     }
 
-    skVector3& operator-=(skScalar v)
+    constexpr skVector3T& operator-=(T v)
     {
         x -= v;
         y -= v;
@@ -158,7 +180,7 @@ public:
         return *this;
     }
 
-    skVector3& operator-=(const skVector3& v)
+    constexpr skVector3T& operator-=(const skVector3T& v)
     {
         x -= v.x;
         y -= v.y;
@@ -166,22 +188,22 @@ public:
         return *this;
     }
 
-    SK_INLINE skVector3 operator-() const
+    SK_INLINE constexpr skVector3T operator-() const
     {
-        return skVector3(-x, -y, -z);
+        return skVector3T(-x, -y, -z);
     }
 
-    SK_INLINE skVector3 operator*(skScalar v) const
+    SK_INLINE constexpr skVector3T operator*(T v) const
     {
-        return skVector3(x * v, y * v, z * v);
+        return skVector3T(x * v, y * v, z * v);
     }
 
-    SK_INLINE skVector3 operator*(const skVector3& v) const
+    SK_INLINE constexpr skVector3T operator*(const skVector3T& v) const
     {
-        return skVector3(x * v.x, y * v.y, z * v.z);
+        return skVector3T(x * v.x, y * v.y, z * v.z);
     }
 
-    skVector3& operator*=(skScalar v)
+    constexpr skVector3T& operator*=(T v)
     {
         x *= v;
         y *= v;
@@ -189,7 +211,7 @@ public:
         return *this;
     }
 
-    skVector3& operator*=(const skVector3& v)
+    constexpr skVector3T& operator*=(const skVector3T& v)
     {
         x *= v.x;
         y *= v.y;
@@ -197,17 +219,17 @@ public:
         return *this;
     }
 
-    SK_INLINE skVector3 operator/(skScalar v) const
+    SK_INLINE constexpr skVector3T operator/(T v) const
     {
-        return skVector3(x / v, y / v, z / v);
+        return skVector3T(x / v, y / v, z / v);
     }
 
-    SK_INLINE skVector3 operator/(const skVector3& v) const
+    SK_INLINE constexpr skVector3T operator/(const skVector3T& v) const
     {
-        return skVector3(x / v.x, y / v.y, z / v.z);
+        return skVector3T(x / v.x, y / v.y, z / v.z);
     }
 
-    skVector3& operator/=(skScalar v)
+    constexpr skVector3T& operator/=(T v)
     {
         x /= v;
         y /= v;
@@ -215,7 +237,7 @@ public:
         return *this;
     }
 
-    skVector3& operator/=(const skVector3& v)
+    constexpr skVector3T& operator/=(const skVector3T& v)
     {
         x /= v.x;
         y /= v.y;
@@ -223,62 +245,62 @@ public:
         return *this;
     }
 
-    SK_INLINE skScalar length() const
+    SK_INLINE T length() const
     {
-        return skSqrt(length2());
+        return Traits::sqrt(length2());
     }
 
-    SK_INLINE skScalar length2() const
+    SK_INLINE constexpr T length2() const
     {
         return x * x + y * y + z * z;
     }
 
-    SK_INLINE skScalar dot(const skVector3& v) const
+    SK_INLINE constexpr T dot(const skVector3T& v) const
     {
         return x * v.x + y * v.y + z * v.z;
     }
 
-    SK_INLINE skScalar distance(const skVector3& v) const
+    SK_INLINE T distance(const skVector3T& v) const
     {
-        return skVector3(x - v.x, y - v.y, z - v.z).length();
+        return skVector3T(x - v.x, y - v.y, z - v.z).length();
     }
 
-    SK_INLINE skScalar distance2(const skVector3& v) const
+    SK_INLINE constexpr T distance2(const skVector3T& v) const
     {
-        return skVector3(x - v.x, y - v.y, z - v.z).length2();
+        return skVector3T(x - v.x, y - v.y, z - v.z).length2();
     }
 
-    skVector3 cross(const skVector3& v) const
+    constexpr skVector3T cross(const skVector3T& v) const
     {
-        return skVector3(
+        return skVector3T(
             y * v.z - z * v.y,
             z * v.x - x * v.z,
             x * v.y - y * v.x);
     }
 
-    SK_INLINE skScalar max3() const
+    SK_INLINE T max3() const
     {
         return skMax3(x, y, z);
     }
 
     void normalize()
     {
-        const skScalar sl = length2();
-        if (sl > SK_EPSILON)
+        const T sl = length2();
+        if (sl > Traits::Epsilon)
         {
-            const skScalar rs = skRSqrt(sl);
+            const T rs = Traits::rsqrt(sl);
             x *= rs;
             y *= rs;
             z *= rs;
         }
     }
 
-    skVector3 normalized() const
+    skVector3T normalized() const
     {
-        const skScalar sl = length2();
-        if (sl > SK_EPSILON)
+        const T sl = length2();
+        if (sl > Traits::Epsilon)
         {
-            const skScalar rs = skRSqrt(sl);
+            const T rs = Traits::rsqrt(sl);
             return {x * rs, y * rs, z * rs};
         }
 
@@ -287,34 +309,128 @@ public:
 
     void print() const;
 
-    skScalar x, y, z;
+    T x, y, z;
 
 public:
-    static const skVector3 Unit;
-    static const skVector3 UnitX;
-    static const skVector3 UnitY;
-    static const skVector3 UnitZ;
-    static const skVector3 Zero;
+    static const skVector3T Unit;
+    static const skVector3T UnitX;
+    static const skVector3T UnitY;
+    static const skVector3T UnitZ;
+    static const skVector3T Zero;
 };
 
-SK_INLINE skVector3 operator-(skScalar r, const skVector3& l)
+template <typename T>
+inline constexpr skVector3T<T> skVector3T<T>::Unit = skVector3T<T>(1, 1, 1);
+template <typename T>
+inline constexpr skVector3T<T> skVector3T<T>::UnitX = skVector3T<T>(1, 0, 0);
+template <typename T>
+inline constexpr skVector3T<T> skVector3T<T>::UnitY = skVector3T<T>(0, 1, 0);
+template <typename T>
+inline constexpr skVector3T<T> skVector3T<T>::UnitZ = skVector3T<T>(0, 0, 1);
+template <typename T>
+inline constexpr skVector3T<T> skVector3T<T>::Zero = skVector3T<T>(0, 0, 0);
+
+template <typename T>
+SK_INLINE constexpr skVector3T<T> operator-(typename skVector3T<T>::ValueType r, const skVector3T<T>& l)
 {
-    return skVector3(l.x - r, l.y - r, l.z - r);
+    return skVector3T<T>(l.x - r, l.y - r, l.z - r);
 }
 
-SK_INLINE skVector3 operator+(skScalar r, const skVector3& l)
+template <typename T>
+SK_INLINE constexpr skVector3T<T> operator+(typename skVector3T<T>::ValueType r, const skVector3T<T>& l)
 {
-    return skVector3(l.x + r, l.y + r, l.z + r);
+    return skVector3T<T>(l.x + r, l.y + r, l.z + r);
 }
 
-SK_INLINE skVector3 operator/(skScalar r, const skVector3& l)
+template <typename T>
+SK_INLINE constexpr skVector3T<T> operator/(typename skVector3T<T>::ValueType r, const skVector3T<T>& l)
 {
-    return skVector3(l.x / r, l.y / r, l.z / r);
+    return skVector3T<T>(l.x / r, l.y / r, l.z / r);
 }
 
-SK_INLINE skVector3 operator*(skScalar r, const skVector3& l)
+template <typename T>
+SK_INLINE constexpr skVector3T<T> operator*(typename skVector3T<T>::ValueType r, const skVector3T<T>& l)
 {
-    return skVector3(l.x * r, l.y * r, l.z * r);
+    return skVector3T<T>(l.x * r, l.y * r, l.z * r);
 }
 
+// The float and double instances are compiled into the library. In
+// header only mode they are instantiated by the caller instead.
+#ifndef SK_MATH_HEADER_ONLY
+extern template class skVector3T<float>;
+extern template class skVector3T<double>;
+#endif
+
+/// <summary>
+/// skVector3 padded to four scalars and aligned to their size, 16 bytes
+/// in single precision. Each one is a single aligned SIMD load, and an
+/// array of them never splits a vector across cache lines. w is padding
+/// that starts at zero.
+/// </summary>
+class alignas(4 * sizeof(skScalar)) skVector3A : public skVector3
+{
+public:
+    skScalar w{};
+
+public:
+    skVector3A() = default;
+
+    constexpr skVector3A(skScalar nx, skScalar ny, skScalar nz) :
+        skVector3(nx, ny, nz)
+    {
+    }
+
+    constexpr skVector3A(const skVector3& v) :
+        skVector3(v)
+    {
+    }
+
+    skVector3A& operator=(const skVector3& v)
+    {
+        skVector3::operator=(v);
+        return *this;
+    }
+};
+
+/// <summary>
+/// Element wise operations over arrays of skVector3 or skVector3A. dst may equal
+/// either input. Single precision runs at the width skSimdDispatch
+/// picks, with AVX-512 covering the tail in masked lanes.
+/// </summary>
+class skVector3Utils
+{
+public:
+    static void add(skVector3* dst, const skVector3* a, const skVector3* b, SKsize count);
+
+    static void sub(skVector3* dst, const skVector3* a, const skVector3* b, SKsize count);
+
+    static void scale(skVector3* dst, const skVector3* a, skScalar s, SKsize count);
+
+    /// <summary>
+    /// Computes dst = a + b * s, such as positions advanced by
+    /// velocities over a time step.
+    /// </summary>
+    static void madd(skVector3* dst, const skVector3* a, const skVector3* b, skScalar s, SKsize count);
+
+    /// <summary>
+    /// Transforms count points by m, as points with w = 1. The bottom
+    /// row of m is ignored, so m should be affine.
+    /// </summary>
+    static void transform(skVector3* dst, const skMatrix4& m, const skVector3* src, SKsize count);
+
+    static void add(skVector3A* dst, const skVector3A* a, const skVector3A* b, SKsize count);
+
+    static void sub(skVector3A* dst, const skVector3A* a, const skVector3A* b, SKsize count);
+
+    static void scale(skVector3A* dst, const skVector3A* a, skScalar s, SKsize count);
+
+    static void madd(skVector3A* dst, const skVector3A* a, const skVector3A* b, skScalar s, SKsize count);
+
+    /// <summary>
+    /// Transforms one point per register in single precision, and
+    /// leaves w at zero for finite input.
+    /// </summary>
+    static void transform(skVector3A* dst, const skMatrix4& m, const skVector3A* src, SKsize count);
+};
+
 #endif  //_skVector3_h_
@@ -27,7 +27,7 @@
 class skVector4
 {
 public:
-    skVector4() :
+    constexpr skVector4() :
         x(0),
         y(0),
         z(0),
@@ -35,7 +35,7 @@ public:
     {
     }
 
-    skVector4(const skScalar nx, const skScalar ny, const skScalar nz, const skScalar nw) :
+    constexpr skVector4(const skScalar nx, const skScalar ny, const skScalar nz, const skScalar nw) :
         x(nx),
         y(ny),
         z(nz),
@@ -43,7 +43,7 @@ public:
     {
     }
 
-    explicit skVector4(const skScalar* p) :
+    constexpr explicit skVector4(const skScalar* p) :
         x(p[0]),
         y(p[1]),
         z(p[2]),
@@ -63,12 +63,12 @@ public:
         return &x;
     }
 
-    SK_INLINE bool operator==(const skVector4& v) const
+    SK_INLINE constexpr bool operator==(const skVector4& v) const
     {
         return skEq(x, v.x) && skEq(y, v.y) && skEq(z, v.z) && skEq(w, v.w);
     }
 
-    SK_INLINE bool operator!=(const skVector4& v) const
+    SK_INLINE constexpr bool operator!=(const skVector4& v) const
     {
         return !skEq(x, v.x) && !skEq(y, v.y) && !skEq(z, v.z) && !skEq(w, v.w);
     }
@@ -82,4 +82,7 @@ public:
     static const skVector4 Zero;
 };
 
+inline constexpr skVector4 skVector4::Unit = skVector4(1, 1, 1, 1);
+inline constexpr skVector4 skVector4::Zero = skVector4(0, 0, 0, 0);
+
 #endif  //_skVector4_h_